@@ -1,9 +1,11 @@
-module alu(
-    input logic [7:0] operand_a,
-    input logic [7:0] operand_b,
+module alu #(
+    parameter DATA_WIDTH = 8  // results wrap modulo 2**DATA_WIDTH
+)(
+    input logic [DATA_WIDTH-1:0] operand_a,
+    input logic [DATA_WIDTH-1:0] operand_b,
     input logic [1:0] alu_op, // 00 = add, 01 = sub, 10 = and, 11 = or
 
-    output logic [7:0] result,
+    output logic [DATA_WIDTH-1:0] result,
     output logic zero_flag
 );
 
@@ -13,11 +15,11 @@ module alu(
             2'b01: result = operand_a - operand_b; // sub
             2'b10: result = operand_a & operand_b; // and
             2'b11: result = operand_a | operand_b; // or
-            default: result = 8'b00000000; // default case
+            default: result = '0; // default case
         endcase
 
         // Set zero flag
-        if (result == 8'b00000000) begin
+        if (result == '0) begin
             zero_flag = 1'b1;
         end else begin
             zero_flag = 1'b0;
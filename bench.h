@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shared pieces of the throughput benchmarks (bench_golden, bench_rtl).
+// Every measurement becomes one JSON line appended to the results file, e.g.
+//   {"bench":"golden.run.sum_loop","value":8.1e+08,"unit":"instr/s","threads":1,"label":"ab12cd3","time":1760000000}
+// so runs of different commits (--label=<git rev>) collect in one file and can be diffed.
+
+struct BenchResult {
+    std::string name;
+    double value;
+    std::string unit;
+    int threads;
+};
+
+class BenchReport {
+    public:
+        BenchReport() : min_seconds_(0.5), output_path_("bench_results.jsonl") {}
+
+        // Common options: --label=L, --output=FILE, --seconds=S (minimum time per measurement);
+        // returns false for anything else so the caller can parse its own options
+        bool parseOption(const std::string& arg) {
+            if (arg.compare(0, 8, "--label=") == 0) {
+                this->label_ = arg.substr(8);
+            } else if (arg.compare(0, 9, "--output=") == 0) {
+                this->output_path_ = arg.substr(9);
+            } else if (arg.compare(0, 10, "--seconds=") == 0) {
+                this->min_seconds_ = std::stod(arg.substr(10));
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        double minSeconds() const { return this->min_seconds_; }
+
+        // Repeats batch() (returns the work units it did) until minSeconds() have passed;
+        // returns units per second
+        template <typename Batch>
+        double measure(Batch batch) {
+            auto start = std::chrono::steady_clock::now();
+            uint64_t units = 0;
+            double seconds = 0;
+            do {
+                units += batch();
+                seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            } while (seconds < this->min_seconds_);
+            return units / seconds;
+        }
+
+        void add(const std::string& name, double value, const std::string& unit, int threads = 1) {
+            this->results_.push_back({ name, value, unit, threads });
+            std::cout << "  " << std::left << std::setw(44) << name << std::right << std::setw(14)
+                      << std::fixed << std::setprecision(0) << value << " " << unit;
+            if (threads > 1) {
+                std::cout << " (" << threads << " threads)";
+            }
+            std::cout << "\n";
+        }
+
+        // Appends all results to the output file
+        bool write() {
+            std::ofstream out(this->output_path_, std::ios::app);
+            if (!out) {
+                std::cerr << "err Cannot write " << this->output_path_ << "\n";
+                return false;
+            }
+            long long now = (long long)std::time(nullptr);
+            for (const BenchResult& result : this->results_) {
+                out << "{\"bench\":\"" << result.name << "\",\"value\":" << std::setprecision(6) << std::scientific
+                    << result.value << ",\"unit\":\"" << result.unit << "\",\"threads\":" << result.threads
+                    << ",\"label\":\"" << this->label_ << "\",\"time\":" << now << "}\n";
+            }
+            std::cout << "\nok " << this->results_.size() << " results appended to " << this->output_path_ << "\n";
+            return (bool)out;
+        }
+
+    private:
+        double min_seconds_;
+        std::string output_path_;
+        std::string label_;
+        std::vector<BenchResult> results_;
+};
+
+// 1, 2, 4, ... up to the core count (the core count itself included)
+inline std::vector<int> bench_thread_counts() {
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int t = 1; t < cores; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(cores);
+    return counts;
+}
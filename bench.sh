@@ -0,0 +1,24 @@
+# Throughput benchmarks; results are appended to bench_results.jsonl, labelled with the commit
+LABEL=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+g++ -O2 -std=c++17 -pthread bench_golden.cpp corpus.cpp sCPU.cpp sCPULanes.cpp -o bench_golden
+./bench_golden --label=$LABEL
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe bench_rtl.cpp campaign.cpp corpus.cpp sCPU.cpp trace_store.cpp \
+  --trace \
+  -CFLAGS "-O2 -pthread" \
+  -LDFLAGS "-pthread"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain --label=$LABEL
@@ -0,0 +1,202 @@
+// Golden model throughput: sCPU instructions/s per execution mode on representative
+// programs, sCPULanes, and random-program scaling over threads. Results are appended
+// to bench_results.jsonl (see bench.h).
+//
+// Usage:
+//   ./bench_golden [--label=<git rev>] [--output=FILE] [--seconds=S]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "corpus.h"
+#include "sCPU.h"
+#include "sCPULanes.h"
+
+// Example program of main_test.cpp: r2 = 1 + 2 + ... + 10, then halts (35 instructions)
+const std::vector<uint8_t> SUM_LOOP = { 0x8A, 0x90, 0xA0, 0xB1, 0x17, 0x29, 0xD1, 0xDF };
+
+// r2 counts up until it wraps to r0 = 0: 256 iterations of add + bner0, then halts
+// (514 instructions)
+const std::vector<uint8_t> COUNT_LOOP = {
+    0b10010001,  // 0: li r1, 1
+    0b00101001,  // 1: add r2, r2, r1
+    0b11000110,  // 2: bner0 r2, 1
+    0b11001101   // 3: bner0 r1, 3
+};
+
+// Branch to itself forever
+const std::vector<uint8_t> HALT_LOOP = {
+    0b10110001,  // 0: li r3, 1
+    0b11000111   // 1: bner0 r3, 1
+};
+
+// Never halts: r1 keeps counting, the state repeats every 512 instructions
+const std::vector<uint8_t> SPIN_LOOP = {
+    0b10110001,  // 0: li r3, 1
+    0b00010111,  // 1: add r1, r1, r3
+    0b11000111   // 2: bner0 r3, 1
+};
+
+void reset_cpu(sCPU& cpu) {
+    cpu.setPc(0);
+    for (int i = 0; i < 4; i++) {
+        cpu.setRegister(i, 0);
+    }
+}
+
+// Instructions the program retires from reset until it halts; it must halt within cap
+uint64_t program_length(const std::vector<uint8_t>& program, uint64_t cap) {
+    sCPU cpu;
+    cpu.loadInstructions(program);
+    sCPU::RunResult result = cpu.run(cap);
+    if (result.stop_reason != sCPU::STOP_HALT) {
+        std::cerr << "err Benchmark program does not halt within " << cap << " instructions\n";
+        std::exit(1);
+    }
+    return result.retired;
+}
+
+// A finite program run from reset over and over, one mode at a time
+void bench_program(BenchReport& report, const std::string& name, const std::vector<uint8_t>& program) {
+    const int repeats = 1000;
+    uint64_t length = program_length(program, 1 << 20);
+    sCPU cpu;
+    cpu.loadInstructions(program);
+
+    report.add("golden.step." + name, report.measure([&]() {
+        uint8_t written_reg, written_value;
+        for (int r = 0; r < repeats; r++) {
+            reset_cpu(cpu);
+            for (uint64_t i = 0; i < length; i++) {
+                cpu.executeInstruction(written_reg, written_value);
+            }
+        }
+        return repeats * length;
+    }), "instr/s");
+
+    report.add("golden.run." + name, report.measure([&]() {
+        uint64_t retired = 0;
+        for (int r = 0; r < repeats; r++) {
+            reset_cpu(cpu);
+            retired += cpu.run(length).retired;
+        }
+        return retired;
+    }), "instr/s");
+
+    sCPU::Profile profile;
+    report.add("golden.run_profiled." + name, report.measure([&]() {
+        uint64_t retired = 0;
+        for (int r = 0; r < repeats; r++) {
+            reset_cpu(cpu);
+            retired += cpu.run(length, profile).retired;
+        }
+        return retired;
+    }), "instr/s");
+
+    report.add("golden.run_blocks." + name, report.measure([&]() {
+        uint64_t retired = 0;
+        for (int r = 0; r < repeats; r++) {
+            reset_cpu(cpu);
+            retired += cpu.runBlocks(length).retired;
+        }
+        return retired;
+    }), "instr/s");
+}
+
+// Random ROM images as in the campaigns: load, then run up to 256 instructions
+uint64_t run_random_programs(const std::vector<std::vector<uint8_t> >& programs, size_t begin, size_t end) {
+    sCPU cpu;
+    uint64_t retired = 0;
+    for (size_t i = begin; i < end; i++) {
+        cpu.loadInstructions(programs[i]);
+        retired += cpu.run(256).retired;
+    }
+    return retired;
+}
+
+int main(int argc, char** argv) {
+    BenchReport report;
+    for (int i = 1; i < argc; i++) {
+        if (!report.parseOption(argv[i])) {
+            std::cerr << "Usage: " << argv[0] << " [--label=L] [--output=FILE] [--seconds=S]\n";
+            return 2;
+        }
+    }
+
+    std::cout << "Golden Model Benchmarks\n";
+    std::cout << "=======================\n\n";
+
+    bench_program(report, "sum_loop", SUM_LOOP);
+    bench_program(report, "count_loop", COUNT_LOOP);
+
+    // Halt loop: a halted CPU stepped like the lockstep harness does
+    sCPU halt_cpu;
+    halt_cpu.loadInstructions(HALT_LOOP);
+    report.add("golden.step.halt_loop", report.measure([&]() {
+        uint8_t written_reg, written_value;
+        for (int i = 0; i < 1000000; i++) {
+            halt_cpu.executeInstruction(written_reg, written_value);
+        }
+        return 1000000;
+    }), "instr/s");
+
+    // Endless loop: block execution, then with cycle fast-forward (periods skipped in O(1))
+    sCPU spin_cpu;
+    spin_cpu.loadInstructions(SPIN_LOOP);
+    report.add("golden.run_blocks.spin_loop", report.measure([&]() {
+        reset_cpu(spin_cpu);
+        return spin_cpu.runBlocks(1000000).retired;
+    }), "instr/s");
+    spin_cpu.setFastForward(true);
+    report.add("golden.run_blocks_ff.spin_loop", report.measure([&]() {
+        reset_cpu(spin_cpu);
+        return spin_cpu.runBlocks(1000000000).retired;
+    }), "instr/s");
+
+    std::vector<std::vector<uint8_t> > programs;
+    for (uint64_t seed = 1; seed <= 4096; seed++) {
+        programs.push_back(generate_program(seed, 16));
+    }
+    report.add("golden.run.random", report.measure([&]() {
+        return run_random_programs(programs, 0, programs.size());
+    }), "instr/s");
+
+    // 32 random programs side by side per sCPULanes step
+    report.add("golden.lanes.random", report.measure([&]() {
+        uint64_t retired = 0;
+        for (size_t first = 0; first + sCPULanes::LANES <= programs.size(); first += sCPULanes::LANES) {
+            sCPULanes lanes;
+            for (int lane = 0; lane < sCPULanes::LANES; lane++) {
+                lanes.loadInstructions(lane, programs[first + lane]);
+            }
+            lanes.run(256);
+            retired += 256 * sCPULanes::LANES;
+        }
+        return retired;
+    }), "instr/s");
+
+    // Scaling of the random-program run over threads
+    for (int threads : bench_thread_counts()) {
+        report.add("golden.run.random.threads", report.measure([&]() {
+            std::atomic<uint64_t> retired(0);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&, t]() {
+                    retired += run_random_programs(programs, programs.size() * t / threads,
+                                                   programs.size() * (t + 1) / threads);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            return retired.load();
+        }), "instr/s", threads);
+    }
+
+    return report.write() ? 0 : 1;
+}
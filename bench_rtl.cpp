@@ -0,0 +1,136 @@
+// RTL simulation throughput: Vmain cycles/s without tracing and with each trace backend,
+// lockstep co-simulation cycles/s, and random-program campaign scaling over threads.
+// Results are appended to bench_results.jsonl (see bench.h). Build with --trace.
+//
+// Usage:
+//   ./obj_dir/Vmain [--label=<git rev>] [--output=FILE] [--seconds=S]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vmain.h"
+#include "Vmain___024root.h"
+#include "bench.h"
+#include "campaign.h"
+#include "lockstep_verilated.h"
+#include "sCPU.h"
+#include "trace_ring_verilated.h"
+#include "trace_store_verilated.h"
+
+const int BATCH_CYCLES = 100000;
+
+// Free-running Vmain on the example program (it halts in a branch-to-self and keeps clocking)
+template <typename Trace>
+double bench_free_run(BenchReport& report, Vmain& cpu, Trace* trace) {
+    VerilatedAdapter<Vmain, Trace> designed(cpu, trace);
+    designed.reset();
+    return report.measure([&]() {
+        for (int i = 0; i < BATCH_CYCLES; i++) {
+            designed.step();
+        }
+        return BATCH_CYCLES;
+    });
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    BenchReport report;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg[0] != '+' && !report.parseOption(arg)) {
+            std::cerr << "Usage: " << argv[0] << " [--label=L] [--output=FILE] [--seconds=S]\n";
+            return 2;
+        }
+    }
+
+    std::cout << "RTL Simulation Benchmarks\n";
+    std::cout << "=========================\n\n";
+
+    {
+        Vmain cpu;
+        report.add("rtl.free_run.no_trace", bench_free_run<NoTrace>(report, cpu, nullptr), "cycles/s");
+    }
+    {
+        Vmain cpu;
+        VerilatedVcdC vcd;
+        cpu.trace(&vcd, 99);
+        vcd.open("bench_trace.vcd");
+        report.add("rtl.free_run.vcd", bench_free_run(report, cpu, &vcd), "cycles/s");
+        vcd.close();
+        std::remove("bench_trace.vcd");
+    }
+    {
+        Vmain cpu;
+        TraceRing<Vmain> ring(cpu, "bench_trace.vcd", 1024);
+        report.add("rtl.free_run.trace_ring", bench_free_run(report, cpu, &ring), "cycles/s");
+    }
+    {
+        Vmain cpu;
+        TraceStore<Vmain> store(cpu);
+        store.open("bench_trace.trc");
+        report.add("rtl.free_run.trace_store", bench_free_run(report, cpu, &store), "cycles/s");
+        store.close();
+        std::remove("bench_trace.trc");
+    }
+
+    // Lockstep against sCPUMain, restarted from reset whenever both CPUs halt
+    {
+        Vmain cpu;
+        cpu.clk = 0;
+        cpu.reset = 0;
+        cpu.eval();
+        std::vector<uint8_t> program(ROM_SIZE);
+        for (int i = 0; i < ROM_SIZE; i++) {
+            program[i] = cpu.rootp->main__DOT__imem_inst__DOT__memory[i];
+        }
+        report.add("lockstep.sum_loop", report.measure([&]() {
+            uint64_t cycles = 0;
+            while (cycles < BATCH_CYCLES) {
+                VerilatedAdapter<Vmain> designed(cpu);
+                designed.reset();
+                sCPUMain golden_cpu;
+                golden_cpu.loadInstructions(program);
+                GoldenAdapter<sCPUMain> golden(golden_cpu);
+                Lockstep<VerilatedAdapter<Vmain>, GoldenAdapter<sCPUMain> > lockstep(designed, golden);
+                while (!lockstep.halted() && cycles < BATCH_CYCLES) {
+                    lockstep.step();
+                    cycles++;
+                }
+            }
+            return cycles;
+        }), "cycles/s");
+    }
+
+    // Random-program campaign (fresh Vmain per program) over threads
+    for (int threads : bench_thread_counts()) {
+        std::atomic<uint64_t> next_seed(1);
+        report.add("campaign.random.threads", report.measure([&]() {
+            const uint64_t batch = 1000;
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&]() {
+                    std::unique_ptr<VerilatedContext> contextp(new VerilatedContext);
+                    Failure failure;
+                    for (uint64_t k = 0; k < batch / threads; k++) {
+                        run_program(contextp.get(), next_seed++, 256, failure);
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            return batch / threads * threads;
+        }), "programs/s", threads);
+    }
+
+    return report.write() ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include <memory>
+#include "campaign.h"
+#include "lockstep_verilated.h"
+#include "trace_ring_verilated.h"
+#include "Vmain___024root.h"
+#include "sCPU.h"
+
+typedef VerilatedAdapter<Vmain, TraceRing<Vmain> > CampaignAdapter;
+
+// Overwrite the RTL ROM through its public memory array
+void load_rom(Vmain* cpu, const uint8_t* program, int size) {
+    for (int i = 0; i < ROM_SIZE; i++) {
+        cpu->rootp->main__DOT__imem_inst__DOT__memory[i] = i < size ? program[i] : 0;
+    }
+}
+
+// Run one ROM image in lockstep on a fresh Vmain and sCPUMain;
+// returns false and fills failure (except its seed) on the first mismatch
+bool run_rom(VerilatedContext* contextp, const uint8_t* program, int size, int max_cycles, Failure& failure,
+             uint64_t trace_cycles, CoverageShard* coverage, const uint64_t* expected_state) {
+    std::unique_ptr<Vmain> designed_cpu(new Vmain(contextp));
+    designed_cpu->clk = 0;
+    designed_cpu->reset = 0;
+    designed_cpu->eval();   // runs the initial block, then replace its program
+    bool passed = run_rom_on(*designed_cpu, program, size, max_cycles, failure, trace_cycles, coverage, expected_state);
+    designed_cpu->final();
+    return passed;
+}
+
+// Same on an existing Vmain: loads the image, resets and runs
+bool run_rom_on(Vmain& designed_cpu, const uint8_t* program, int size, int max_cycles, Failure& failure,
+                uint64_t trace_cycles, CoverageShard* coverage, const uint64_t* expected_state) {
+    load_rom(&designed_cpu, program, size);
+
+    // Deferred trace: untriggered it is never written, so it can stay on for whole campaigns
+    std::unique_ptr<TraceRing<Vmain> > ring;
+    if (trace_cycles > 0) {
+        ring.reset(new TraceRing<Vmain>(designed_cpu, "campaign_" + std::to_string(failure.seed) + ".vcd", trace_cycles));
+    }
+    CampaignAdapter designed(designed_cpu, ring.get());
+    designed.reset();
+
+    // Sized like main.sv, so both PCs wrap from 15 to 0
+    sCPUMain golden_cpu;
+    golden_cpu.loadInstructions(program, size);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+
+    Lockstep<CampaignAdapter, GoldenAdapter<sCPUMain> > lockstep(designed, golden);
+    int cycle = 0;
+    for (; cycle < max_cycles; cycle++) {
+        bool match = coverage != nullptr ? lockstep.step(*coverage) : lockstep.step();
+        if (!match) {
+            failure.cycle = cycle;
+            failure.reason = describe_mismatch(lockstep.designedState(), lockstep.goldenState());
+            failure.rom.assign(program, program + size);
+            if (ring) {
+                ring->trigger("mismatch at cycle " + std::to_string(cycle) + ": " + failure.reason);
+                ring->flush();
+            }
+            return false;
+        }
+
+        if (lockstep.halted()) {
+            break;
+        }
+    }
+
+    // Both CPUs agree, but not on the state the program was recorded with
+    if (expected_state != nullptr && lockstep.designedState() != *expected_state) {
+        failure.cycle = cycle;
+        failure.reason = "final state differs from the recorded one: "
+                       + describe_mismatch(lockstep.designedState(), *expected_state);
+        failure.rom.assign(program, program + size);
+        if (ring) {
+            ring->trigger(failure.reason);
+            ring->flush();
+        }
+        return false;
+    }
+    return true;
+}
+
+// Same for the random program generated from seed
+bool run_program(VerilatedContext* contextp, uint64_t seed, int max_cycles, Failure& failure,
+                 uint64_t trace_cycles, CoverageShard* coverage) {
+    std::vector<uint8_t> program = generate_program(seed, ROM_SIZE);
+    failure.seed = seed;
+    return run_rom(contextp, program.data(), program.size(), max_cycles, failure, trace_cycles, coverage);
+}
+
+// Same for program index of a corpus; metadata (if any) supplies the seed and cycle budget
+bool run_corpus_program(VerilatedContext* contextp, CorpusReader& corpus, uint64_t index, int max_cycles, Failure& failure,
+                        uint64_t trace_cycles, CoverageShard* coverage) {
+    const CorpusMetadata* metadata = corpus.metadata(index);
+    failure.seed = metadata != nullptr ? metadata->seed : index;
+    failure.index = index;
+    if (metadata != nullptr && metadata->cycle_budget != 0) {
+        max_cycles = metadata->cycle_budget;
+    }
+    uint64_t expected_state = 0;
+    bool has_expected = metadata != nullptr && (metadata->flags & CORPUS_HAS_EXPECTED) != 0;
+    if (has_expected) {
+        expected_state = pack_state(metadata->expected_pc, metadata->expected_regs);
+    }
+    return run_rom(contextp, corpus.rom(index), corpus.romSize(), max_cycles, failure, trace_cycles, coverage,
+                   has_expected ? &expected_state : nullptr);
+}
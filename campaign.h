@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <verilated.h>
+#include "Vmain.h"
+#include "corpus.h"
+#include "coverage.h"
+
+// Shared lockstep pieces of the random-program campaigns (campaign_test, campaign_shard_test)
+
+const int ROM_SIZE = 16;
+
+struct Failure {
+    uint64_t seed;              // generator seed, or corpus metadata seed / program index
+    uint64_t index;             // corpus program index (corpus runs only)
+    int cycle;
+    std::string reason;
+    std::vector<uint8_t> rom;
+};
+
+// Overwrite the RTL ROM through its public memory array
+void load_rom(Vmain* cpu, const uint8_t* program, int size);
+
+// Run one ROM image in lockstep on a fresh Vmain and sCPUMain;
+// returns false and fills failure (except its seed) on the first mismatch.
+// trace_cycles > 0 keeps that many cycles in a deferred trace ring (trace_ring.h), written
+// to campaign_<seed>.vcd only on a mismatch (failure.seed must already be set).
+// coverage (if set) samples the RTL control path of every cycle (coverage.h).
+// expected_state (if set) is the packed state (pack_state) the run must end in.
+bool run_rom(VerilatedContext* contextp, const uint8_t* program, int size, int max_cycles, Failure& failure,
+             uint64_t trace_cycles = 0, CoverageShard* coverage = nullptr, const uint64_t* expected_state = nullptr);
+
+// Same on an existing Vmain, for running many programs back to back: loads the image
+// through the public ROM array and resets the CPU (PC and register file) first
+bool run_rom_on(Vmain& designed_cpu, const uint8_t* program, int size, int max_cycles, Failure& failure,
+                uint64_t trace_cycles = 0, CoverageShard* coverage = nullptr, const uint64_t* expected_state = nullptr);
+
+// Same for the random program generated from seed
+bool run_program(VerilatedContext* contextp, uint64_t seed, int max_cycles, Failure& failure,
+                 uint64_t trace_cycles = 0, CoverageShard* coverage = nullptr);
+
+// Same for program index of a corpus; metadata (if any) supplies the seed and cycle budget,
+// and with CORPUS_HAS_EXPECTED the run also fails if it does not end in the recorded state
+bool run_corpus_program(VerilatedContext* contextp, CorpusReader& corpus, uint64_t index, int max_cycles, Failure& failure,
+                        uint64_t trace_cycles = 0, CoverageShard* coverage = nullptr);
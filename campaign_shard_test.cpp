@@ -0,0 +1,349 @@
+// Multi-process sharded campaign: designed CPU (Vmain) vs golden CPU (sCPU).
+// A coordinator process forks worker processes and talks to them only through one
+// shared-memory region:
+//   - a task ring of seed ranges (coordinator produces, workers claim with a CAS),
+//   - one slot per worker with pass/fail counters, the seed it is running, and an
+//     SPSC ring of failing seeds (worker produces, coordinator drains).
+// A worker that crashes (e.g. a Verilator assertion) is respawned; the seed it was
+// running is reported as a failure and the rest of its range goes back into the ring.
+// Workers run the same lockstep as campaign_test (campaign.cpp).
+//
+// Options:
+//   --programs=N      number of programs (default 1000000)
+//   --seed=S          seed of the first program (default 1)
+//   --workers=W       worker processes (default: all cores)
+//   --cycles=C        per-program cycle cap (default 256)
+//   --chunk=K         seeds per task (default 1024)
+//   --crash-seed=S    abort the worker on seed S (exercises the respawn path)
+//   --corpus=FILE     run the programs of a corpus file instead of seeds; tasks are
+//                     then slices of program indices of the mapping each worker inherits
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <verilated.h>
+#include "campaign.h"
+#include "options.h"
+
+uint64_t program_count = 1000000;
+uint64_t base_seed = 1;
+int worker_count = 0;
+int max_cycles = 256;
+uint64_t chunk_size = 1024;
+uint64_t crash_seed = ~0ull;
+std::string corpus_path;
+CorpusReader corpus;
+
+const int TASK_RING_SIZE = 64;
+const int FAILURE_RING_SIZE = 256;
+const int MAX_WORKERS = 256;
+
+// Seed range [first, end)
+struct ShardTask {
+    std::atomic<uint64_t> first;
+    std::atomic<uint64_t> end;
+};
+
+struct FailureRecord {
+    uint64_t seed;
+    int32_t cycle;      // -1: worker crashed
+    char reason[84];
+};
+
+struct WorkerSlot {
+    std::atomic<uint32_t> busy;             // running a claimed range
+    std::atomic<uint64_t> current_seed;     // seed being run while busy
+    std::atomic<uint64_t> range_end;        // end of the claimed range
+    std::atomic<uint64_t> passed;
+    std::atomic<uint64_t> failed;
+
+    // Failing seeds: worker writes at tail, coordinator reads at head
+    std::atomic<uint64_t> failure_head;
+    std::atomic<uint64_t> failure_tail;
+    FailureRecord failures[FAILURE_RING_SIZE];
+};
+
+struct SharedRegion {
+    std::atomic<uint32_t> shutdown;         // no more tasks will be produced
+    std::atomic<uint64_t> task_head;        // next task to claim
+    std::atomic<uint64_t> task_tail;        // next free task slot
+    ShardTask tasks[TASK_RING_SIZE];
+    WorkerSlot workers[MAX_WORKERS];
+};
+
+// ========== Worker process ==========
+
+// Claim the next seed range into slot; false once the ring is empty and the coordinator
+// is done. The range is published in the slot before the CAS, so a crash right after a
+// successful claim still hands it back to the coordinator.
+bool claim_task(SharedRegion* shared, WorkerSlot& slot, uint64_t& first, uint64_t& end) {
+    for (;;) {
+        uint64_t head = shared->task_head.load();
+        if (head == shared->task_tail.load()) {
+            // Tasks are pushed before shutdown is raised: re-check the ring after seeing it
+            if (shared->shutdown.load() && head == shared->task_tail.load()) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        first = shared->tasks[head % TASK_RING_SIZE].first.load();
+        end = shared->tasks[head % TASK_RING_SIZE].end.load();
+        slot.range_end.store(end);
+        slot.current_seed.store(first);
+        slot.busy.store(1);
+        if (shared->task_head.compare_exchange_weak(head, head + 1)) {
+            return true;
+        }
+        slot.busy.store(0);     // another worker claimed it
+    }
+}
+
+void publish_failure(WorkerSlot& slot, const Failure& failure) {
+    uint64_t tail = slot.failure_tail.load();
+    while (tail - slot.failure_head.load() >= FAILURE_RING_SIZE) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    FailureRecord& record = slot.failures[tail % FAILURE_RING_SIZE];
+    record.seed = failure.seed;
+    record.cycle = failure.cycle;
+    std::strncpy(record.reason, failure.reason.c_str(), sizeof(record.reason) - 1);
+    record.reason[sizeof(record.reason) - 1] = 0;
+    slot.failure_tail.store(tail + 1);
+}
+
+int worker_main(SharedRegion* shared, int self) {
+    WorkerSlot& slot = shared->workers[self];
+    std::unique_ptr<VerilatedContext> contextp(new VerilatedContext);
+
+    uint64_t first, end;
+    Failure failure;
+    while (claim_task(shared, slot, first, end)) {
+        for (uint64_t seed = first; seed < end; seed++) {
+            slot.current_seed.store(seed);
+            if (seed == crash_seed) {
+                std::abort();
+            }
+            bool passed = corpus_path.empty()
+                        ? run_program(contextp.get(), seed, max_cycles, failure)
+                        : run_corpus_program(contextp.get(), corpus, seed, max_cycles, failure);
+            if (passed) {
+                slot.passed++;
+            } else {
+                publish_failure(slot, failure);
+                slot.failed++;
+            }
+        }
+
+        slot.busy.store(0);
+    }
+    return 0;
+}
+
+// ========== Coordinator ==========
+
+pid_t spawn_worker(SharedRegion* shared, int self) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(worker_main(shared, self));
+    }
+    return pid;
+}
+
+bool push_task(SharedRegion* shared, uint64_t first, uint64_t end) {
+    uint64_t tail = shared->task_tail.load();
+    if (tail - shared->task_head.load() >= TASK_RING_SIZE) {
+        return false;
+    }
+    shared->tasks[tail % TASK_RING_SIZE].first.store(first);
+    shared->tasks[tail % TASK_RING_SIZE].end.store(end);
+    shared->task_tail.store(tail + 1);
+    return true;
+}
+
+void drain_failures(WorkerSlot& slot, std::vector<FailureRecord>& failures) {
+    uint64_t head = slot.failure_head.load();
+    uint64_t tail = slot.failure_tail.load();
+    for (; head < tail; head++) {
+        failures.push_back(slot.failures[head % FAILURE_RING_SIZE]);
+    }
+    slot.failure_head.store(head);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string text;
+        std::string arg = argv[i];
+        if (parse_option(arg, "programs", value)) {
+            program_count = value;
+        } else if (parse_option(arg, "seed", value)) {
+            base_seed = value;
+        } else if (parse_option(arg, "workers", value)) {
+            worker_count = value;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_cycles = value;
+        } else if (parse_option(arg, "chunk", value)) {
+            chunk_size = std::max<uint64_t>(1, value);
+        } else if (parse_option(arg, "crash-seed", value)) {
+            crash_seed = value;
+        } else if (parse_option(arg, "corpus", text)) {
+            corpus_path = text;
+        } else if (unknown_option(arg)) {
+            return 1;
+        }
+    }
+    if (!corpus_path.empty()) {
+        if (!corpus.open(corpus_path)) {
+            return 1;
+        }
+        base_seed = 0;
+        program_count = corpus.size();
+    }
+    if (worker_count <= 0) {
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    worker_count = std::min(worker_count, MAX_WORKERS);
+
+    std::cout << "Sharded Random Program Campaign (Designed CPU vs Golden CPU)\n";
+    std::cout << "=============================================================\n\n";
+    std::cout << "Programs: " << program_count << ", "
+              << (corpus_path.empty() ? "seeds " + std::to_string(base_seed) + ".." + std::to_string(base_seed + program_count - 1)
+                                      : "corpus " + corpus_path)
+              << ", workers: " << worker_count << ", chunk: " << chunk_size << ", cycle cap: " << max_cycles << "\n\n";
+
+    // Anonymous shared mapping, inherited by every (re)spawned worker
+    void* mapping = mmap(nullptr, sizeof(SharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "err mmap failed: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    SharedRegion* shared = new (mapping) SharedRegion();
+
+    auto start = std::chrono::steady_clock::now();
+    std::cout.flush();
+
+    std::vector<pid_t> pids(worker_count);
+    for (int w = 0; w < worker_count; w++) {
+        pids[w] = spawn_worker(shared, w);
+    }
+
+    std::vector<FailureRecord> failures;
+    std::vector<std::pair<uint64_t, uint64_t>> requeued;
+    uint64_t next_seed = base_seed;
+    uint64_t end_seed = base_seed + program_count;
+    int running = worker_count;
+    int respawns = 0;
+
+    while (running > 0) {
+        // Produce: ranges returned by crashed workers first, then fresh chunks
+        while (!requeued.empty() && push_task(shared, requeued.back().first, requeued.back().second)) {
+            requeued.pop_back();
+        }
+        while (requeued.empty() && next_seed < end_seed
+               && push_task(shared, next_seed, std::min(end_seed, next_seed + chunk_size))) {
+            next_seed = std::min(end_seed, next_seed + chunk_size);
+        }
+        if (requeued.empty() && next_seed == end_seed) {
+            shared->shutdown.store(1);
+        }
+
+        for (int w = 0; w < worker_count; w++) {
+            drain_failures(shared->workers[w], failures);
+        }
+
+        // Reap exited workers; respawn the ones that crashed
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            int w = std::find(pids.begin(), pids.end(), pid) - pids.begin();
+            if (w == worker_count) {
+                continue;
+            }
+            WorkerSlot& slot = shared->workers[w];
+            drain_failures(slot, failures);
+
+            bool crashed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            if (!crashed) {
+                pids[w] = -1;
+                running--;
+                continue;
+            }
+
+            if (slot.busy.load()) {
+                uint64_t seed = slot.current_seed.load();
+                FailureRecord record = {};
+                record.seed = seed;
+                record.cycle = -1;
+                std::snprintf(record.reason, sizeof(record.reason), "worker crashed (%s %d)",
+                              WIFSIGNALED(status) ? "signal" : "exit code",
+                              WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+                failures.push_back(record);
+                slot.failed++;
+                if (seed + 1 < slot.range_end.load()) {
+                    requeued.push_back(std::make_pair(seed + 1, slot.range_end.load()));
+                }
+                slot.busy.store(0);
+            }
+            shared->shutdown.store(0);
+            pids[w] = spawn_worker(shared, w);
+            respawns++;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t passed = 0, failed = 0;
+    for (int w = 0; w < worker_count; w++) {
+        passed += shared->workers[w].passed.load();
+        failed += shared->workers[w].failed.load();
+    }
+    munmap(mapping, sizeof(SharedRegion));
+
+    std::sort(failures.begin(), failures.end(),
+              [](const FailureRecord& a, const FailureRecord& b) { return a.seed < b.seed; });
+
+    std::cout << "Ran " << passed + failed << " programs in " << std::fixed << std::setprecision(2) << seconds
+              << " s (" << (uint64_t)((passed + failed) / std::max(seconds, 1e-9)) << " programs/s), "
+              << respawns << " worker respawns\n";
+    std::cout << "Passed: " << passed << ", failed: " << failed << "\n";
+    if (passed + failed != program_count) {
+        std::cout << "\nerr " << passed + failed << " results for " << program_count << " programs (lost or repeated ranges)\n";
+        return 1;
+    }
+
+    if (failures.empty()) {
+        std::cout << "\nok All programs passed! CPUs match.\n";
+        return 0;
+    }
+
+    std::ofstream report("campaign_failures.txt");
+    for (const FailureRecord& failure : failures) {
+        report << failure.seed << " cycle " << failure.cycle << ": " << failure.reason << "\n";
+    }
+
+    std::cout << "\nerr " << failures.size() << " failing programs (all seeds in campaign_failures.txt)\n";
+    for (size_t i = 0; i < failures.size() && i < 10; i++) {
+        std::cout << "  seed " << failures[i].seed << ", cycle " << std::setw(3) << failures[i].cycle << ": "
+                  << failures[i].reason << "\n";
+    }
+    return 1;
+}
@@ -0,0 +1,18 @@
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe campaign_shard_test.cpp campaign.cpp corpus.cpp sCPU.cpp \
+  --trace \
+  -CFLAGS "-O2 -pthread" \
+  -LDFLAGS "-pthread"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain --programs=1000000 --seed=1
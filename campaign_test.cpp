@@ -0,0 +1,259 @@
+// Random-program differential campaign: designed CPU (Vmain) vs golden CPU (sCPU).
+// Every job is a seed; the seed fully determines a random 16-byte ROM image, which is
+// run in lockstep on a fresh Vmain and sCPU. Jobs are spread over all cores with a
+// work-stealing scheduler (one VerilatedContext per worker thread).
+//
+// Options:
+//   --programs=N   number of programs (default 100000)
+//   --seed=S       seed of the first program, job i uses seed S+i (default 1)
+//   --threads=T    worker threads (default: all cores)
+//   --cycles=C     per-program cycle cap (default 256)
+//   --corpus=FILE  run the programs of a corpus file (see corpus.h) instead of seeds
+//   --first=I      first corpus program to run (default 0); --programs caps the count
+//   --trace-ring=N keep the last N cycles of each program in a deferred trace ring,
+//                  written to campaign_<seed>.vcd for failing programs only
+//   --coverage=FILE collect functional coverage of the RTL (coverage.h), one shard per
+//                  worker merged lock-free at the end, and write the database to FILE
+//   --saturate=N   stop once N programs in a row covered no new point (implies coverage)
+// Reproduce a failure with --seed=<failing seed> --programs=1, or for a corpus run with
+// --corpus=FILE --first=<failing program index> --programs=1 (printed with the failures)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <verilated.h>
+#include "campaign.h"
+#include "options.h"
+
+uint64_t program_count = 100000;
+bool program_count_set = false;
+uint64_t base_seed = 1;
+int thread_count = 0;
+int max_cycles = 256;
+uint64_t trace_cycles = 0;
+std::string corpus_path;
+uint64_t corpus_first = 0;
+CorpusReader corpus;
+std::string coverage_path;
+uint64_t saturate_programs = 0;
+CoverageDatabase coverage;
+std::atomic<uint64_t> last_new_coverage(0);    // programs done when a point was last new
+
+// Per-worker range of job indices; an idle worker steals half of another worker's range
+struct WorkQueue {
+    std::mutex mutex;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+};
+
+// Take the next job: own range first, otherwise steal the upper half of another worker's range
+bool next_job(std::vector<WorkQueue>& queues, int self, uint64_t& job) {
+    {
+        std::lock_guard<std::mutex> lock(queues[self].mutex);
+        if (queues[self].begin < queues[self].end) {
+            job = queues[self].begin++;
+            return true;
+        }
+    }
+
+    int worker_count = queues.size();
+    for (int k = 1; k < worker_count; k++) {
+        WorkQueue& victim = queues[(self + k) % worker_count];
+        uint64_t stolen_begin, stolen_end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            uint64_t remaining = victim.end - victim.begin;
+            if (remaining == 0) {
+                continue;
+            }
+            stolen_end = victim.end;
+            stolen_begin = victim.end - (remaining + 1) / 2;
+            victim.end = stolen_begin;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            queues[self].begin = stolen_begin + 1;
+            queues[self].end = stolen_end;
+        }
+        job = stolen_begin;
+        return true;
+    }
+    return false;
+}
+
+void worker(int self, std::vector<WorkQueue>& queues, std::vector<Failure>& failures,
+            std::atomic<uint64_t>& programs_done) {
+    std::unique_ptr<VerilatedContext> contextp(new VerilatedContext);
+
+    // This worker's coverage: counters stay local, only new bitmap bits are published
+    CoverageShard shard;
+    CoverageShard* shard_ptr = (!coverage_path.empty() || saturate_programs > 0) ? &shard : nullptr;
+    uint64_t published = 0;
+
+    uint64_t job;
+    Failure failure;
+    while (next_job(queues, self, job)) {
+        bool passed = corpus_path.empty()
+                    ? run_program(contextp.get(), base_seed + job, max_cycles, failure, trace_cycles, shard_ptr)
+                    : run_corpus_program(contextp.get(), corpus, corpus_first + job, max_cycles, failure, trace_cycles,
+                                         shard_ptr);
+        if (!passed) {
+            failures.push_back(failure);
+        }
+        uint64_t done = ++programs_done;
+
+        if (shard_ptr != nullptr && (shard.bitmap & ~published) != 0) {
+            published = shard.bitmap;
+            if (coverage.mergeBitmap(published) != 0) {
+                last_new_coverage.store(done, std::memory_order_relaxed);
+            }
+        }
+        if (saturate_programs > 0 && done - last_new_coverage.load(std::memory_order_relaxed) >= saturate_programs) {
+            break;
+        }
+    }
+    coverage.merge(shard);
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string text;
+        std::string arg = argv[i];
+        if (parse_option(arg, "programs", value)) {
+            program_count = value;
+            program_count_set = true;
+        } else if (parse_option(arg, "seed", value)) {
+            base_seed = value;
+        } else if (parse_option(arg, "threads", value)) {
+            thread_count = value;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_cycles = value;
+        } else if (parse_option(arg, "trace-ring", value)) {
+            trace_cycles = value;
+        } else if (parse_option(arg, "saturate", value)) {
+            saturate_programs = value;
+        } else if (parse_option(arg, "coverage", text)) {
+            coverage_path = text;
+        } else if (parse_option(arg, "corpus", text)) {
+            corpus_path = text;
+        } else if (parse_option(arg, "first", value)) {
+            corpus_first = value;
+        } else if (unknown_option(arg)) {
+            return 1;
+        }
+    }
+    if (!corpus_path.empty()) {
+        if (!corpus.open(corpus_path)) {
+            return 1;
+        }
+        if (corpus_first >= corpus.size()) {
+            std::cerr << "err --first=" << corpus_first << " is past the " << corpus.size() << " programs of "
+                      << corpus_path << "\n";
+            return 1;
+        }
+        uint64_t available = corpus.size() - corpus_first;
+        program_count = program_count_set ? std::min(program_count, available) : available;
+    }
+    if (thread_count <= 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::cout << "Random Program Campaign (Designed CPU vs Golden CPU)\n";
+    std::cout << "====================================================\n\n";
+    std::cout << "Programs: " << program_count << ", "
+              << (corpus_path.empty() ? "seeds " + std::to_string(base_seed) + ".." + std::to_string(base_seed + program_count - 1)
+                                      : "corpus " + corpus_path + " programs " + std::to_string(corpus_first) + ".."
+                                        + std::to_string(corpus_first + program_count - 1))
+              << ", threads: " << thread_count << ", cycle cap: " << max_cycles << "\n\n";
+
+    // Split the job indices evenly; stealing rebalances uneven program lengths
+    std::vector<WorkQueue> queues(thread_count);
+    for (int t = 0; t < thread_count; t++) {
+        queues[t].begin = program_count * t / thread_count;
+        queues[t].end = program_count * (t + 1) / thread_count;
+    }
+
+    std::vector<std::vector<Failure>> failures(thread_count);
+    std::atomic<uint64_t> programs_done(0);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back(worker, t, std::ref(queues), std::ref(failures[t]), std::ref(programs_done));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Failing-seed report
+    std::vector<Failure> all_failures;
+    for (auto& thread_failures : failures) {
+        all_failures.insert(all_failures.end(), thread_failures.begin(), thread_failures.end());
+    }
+    bool by_index = !corpus_path.empty();
+    std::sort(all_failures.begin(), all_failures.end(), [by_index](const Failure& a, const Failure& b) {
+        return by_index ? a.index < b.index : a.seed < b.seed;
+    });
+
+    std::cout << "Ran " << programs_done << " programs in " << std::fixed << std::setprecision(2) << seconds
+              << " s (" << (uint64_t)(programs_done / std::max(seconds, 1e-9)) << " programs/s)\n";
+
+    if (!coverage_path.empty() || saturate_programs > 0) {
+        std::cout << "\n";
+        coverage.report(std::cout);
+        if (saturate_programs > 0 && programs_done < program_count) {
+            std::cout << "ok Coverage saturated: no new point in the last " << saturate_programs << " programs\n";
+        }
+        if (!coverage_path.empty() && coverage.write(coverage_path)) {
+            std::cout << "Coverage database: " << coverage_path << "\n";
+        }
+    }
+
+    if (all_failures.empty()) {
+        std::cout << "\nok All programs passed! CPUs match.\n";
+        return 0;
+    }
+
+    std::ofstream report("campaign_failures.txt");
+    for (const Failure& failure : all_failures) {
+        if (by_index) {
+            report << "program " << failure.index << " seed ";
+        }
+        report << failure.seed << " cycle " << failure.cycle << ": " << failure.reason << "\n";
+    }
+
+    std::cout << "\nerr " << all_failures.size() << " failing programs (all in campaign_failures.txt)\n";
+    for (size_t i = 0; i < all_failures.size() && i < 10; i++) {
+        const Failure& failure = all_failures[i];
+        std::cout << "  ";
+        if (by_index) {
+            std::cout << "program " << failure.index << " ";
+        }
+        std::cout << "seed " << failure.seed << ", cycle " << std::setw(3) << failure.cycle << ": " << failure.reason
+                  << "\n    ROM:";
+        for (uint8_t byte : failure.rom) {
+            std::cout << " " << std::hex << std::setw(2) << std::setfill('0') << (int)byte << std::dec << std::setfill(' ');
+        }
+        std::cout << "\n";
+    }
+    const Failure& first = all_failures[0];
+    std::cout << "Reproduce: ./obj_dir/Vmain "
+              << (by_index ? "--corpus=" + corpus_path + " --first=" + std::to_string(first.index)
+                           : "--seed=" + std::to_string(first.seed))
+              << " --programs=1\n";
+    return 1;
+}
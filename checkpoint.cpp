@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "checkpoint.h"
+
+bool write_checkpoint(const std::string& path, const Checkpoint& checkpoint) {
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.cycle = checkpoint.cycle;
+    header.time = checkpoint.time;
+    header.rtl_size = checkpoint.rtl.size();
+    header.golden_pc = checkpoint.golden_pc;
+    std::memcpy(header.golden_regs, checkpoint.golden_regs, sizeof(header.golden_regs));
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "err Cannot create " << path << "\n";
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+           && std::fwrite(checkpoint.golden_imem, sizeof(checkpoint.golden_imem), 1, file) == 1
+           && (checkpoint.rtl.empty() || std::fwrite(checkpoint.rtl.data(), checkpoint.rtl.size(), 1, file) == 1);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "err Cannot write " << path << "\n";
+    }
+    return ok;
+}
+
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+
+    CheckpointHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1
+           && std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) == 0
+           && header.version == CHECKPOINT_VERSION
+           && std::fread(checkpoint.golden_imem, sizeof(checkpoint.golden_imem), 1, file) == 1;
+    if (ok) {
+        // The model image is the rest of the file: check the size before allocating it
+        long position = std::ftell(file);
+        ok = position >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+        long end = ok ? std::ftell(file) : -1;
+        ok = ok && end >= position && header.rtl_size == (uint64_t)(end - position)
+          && std::fseek(file, position, SEEK_SET) == 0;
+    }
+    if (ok) {
+        checkpoint.rtl.resize(header.rtl_size);
+        ok = checkpoint.rtl.empty() || std::fread(checkpoint.rtl.data(), checkpoint.rtl.size(), 1, file) == 1;
+    }
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "err " << path << " is not a valid checkpoint (version " << CHECKPOINT_VERSION << ")\n";
+        return false;
+    }
+
+    checkpoint.cycle = header.cycle;
+    checkpoint.time = header.time;
+    checkpoint.golden_pc = header.golden_pc;
+    std::memcpy(checkpoint.golden_regs, header.golden_regs, sizeof(header.golden_regs));
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Snapshot of a co-simulation at a cycle boundary: the Verilated model (Verilator's
+// --savable serialization, see checkpoint_verilated.h), the golden CPU's architectural state
+// and instruction memory, and the harness counters. Restoring one continues the run exactly
+// where it was taken, in the same process or (through a file) in a new one, e.g. to re-run
+// only the window before a mismatch with tracing enabled.
+//
+// File layout (little-endian):
+//   CheckpointHeader (64 bytes)
+//   golden instruction memory, 256 bytes (one per 8-bit PC value)
+//   Verilator save image, rtl_size bytes
+
+const char CHECKPOINT_MAGIC[8] = { 's', 'I', 'S', 'A', 'C', 'K', 'P', 'T' };
+const uint32_t CHECKPOINT_VERSION = 2;   // 2: no program end (only a taken self-branch halts)
+
+struct Checkpoint {
+    uint64_t cycle;                 // harness cycle counter (cycles since reset was released)
+    uint64_t time;                  // VerilatedAdapter edge time, so traces continue seamlessly
+    uint8_t golden_pc;
+    uint8_t golden_regs[4];
+    uint8_t golden_imem[256];
+    std::vector<uint8_t> rtl;       // Verilator save image; empty for a golden-only checkpoint
+};
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t padding;
+    uint64_t cycle;
+    uint64_t time;
+    uint64_t rtl_size;
+    uint8_t golden_pc;
+    uint8_t golden_regs[4];
+    uint8_t reserved[19];
+};
+static_assert(sizeof(CheckpointHeader) == 64, "checkpoint header must stay 64 bytes");
+
+bool write_checkpoint(const std::string& path, const Checkpoint& checkpoint);
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint);
+
+// Golden CPU part, for any model with the sCPU interface (sCPU, sCPUMain, ...)
+template <typename CPU>
+void save_golden(CPU& cpu, Checkpoint& checkpoint) {
+    checkpoint.golden_pc = cpu.getPc();
+    for (int i = 0; i < 4; i++) {
+        checkpoint.golden_regs[i] = cpu.getRegister(i);
+    }
+    for (int i = 0; i < 256; i++) {
+        checkpoint.golden_imem[i] = cpu.fetchInstruction(i);
+    }
+}
+
+// Reloads the instruction memory (and so the decoded program), then the state
+template <typename CPU>
+void restore_golden(CPU& cpu, const Checkpoint& checkpoint) {
+    cpu.loadInstructions(std::vector<uint8_t>(checkpoint.golden_imem, checkpoint.golden_imem + 256));
+    cpu.setPc(checkpoint.golden_pc);
+    for (int i = 0; i < 4; i++) {
+        cpu.setRegister(i, checkpoint.golden_regs[i]);
+    }
+}
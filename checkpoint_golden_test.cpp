@@ -0,0 +1,124 @@
+// Checkpoint files without a Verilated model: a golden-only checkpoint written to a file
+// and restored into a fresh sCPUMain must continue the run cycle for cycle, and damaged
+// files must be rejected before anything is allocated.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "checkpoint.h"
+#include "lockstep.h"
+#include "sCPU.h"
+
+// Endless loop (same as checkpoint_test.cpp)
+const uint8_t LOOP[] = {
+    0b10001111,  // 0: li r0, 15
+    0b10110001,  // 1: li r3, 1
+    0b00010111,  // 2: add r1, r1, r3
+    0b00101001,  // 3: add r2, r2, r1
+    0b11001011   // 4: bner0 r3, 2
+};
+
+// Packed states for cycles cycles
+std::vector<uint64_t> run(sCPUMain& cpu, int cycles) {
+    GoldenAdapter<sCPUMain> adapter(cpu);
+    std::vector<uint64_t> states;
+    for (int i = 0; i < cycles; i++) {
+        adapter.step();
+        states.push_back(adapter.packedState());
+    }
+    return states;
+}
+
+std::vector<uint8_t> read_file(const char* path) {
+    std::vector<uint8_t> bytes;
+    FILE* file = std::fopen(path, "rb");
+    int c;
+    while ((c = std::fgetc(file)) != EOF) {
+        bytes.push_back(c);
+    }
+    std::fclose(file);
+    return bytes;
+}
+
+void write_file(const char* path, const std::vector<uint8_t>& bytes) {
+    FILE* file = std::fopen(path, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+int main() {
+    std::cout << "Testing golden-only checkpoint files\n";
+    std::cout << "====================================\n\n";
+
+    const char* path = "checkpoint_golden_test.ckpt";
+
+    sCPUMain cpu;
+    cpu.loadInstructions(LOOP, sizeof(LOOP));
+    run(cpu, 1000);
+
+    Checkpoint checkpoint;
+    save_golden(cpu, checkpoint);
+    checkpoint.cycle = 1000;
+    checkpoint.time = 2001;
+    std::vector<uint64_t> reference = run(cpu, 5000);
+
+    // Test 1: save -> file -> fresh CPU -> continue
+    std::cout << "Test 1: Restore from a file into a fresh sCPUMain\n";
+    if (!write_checkpoint(path, checkpoint)) {
+        std::cerr << "  ✗ FAIL: cannot write " << path << "\n";
+        return 1;
+    }
+    Checkpoint loaded;
+    loaded.rtl.assign(16, 0xAA);
+    sCPUMain fresh;
+    if (!read_checkpoint(path, loaded) || loaded.cycle != 1000 || loaded.time != 2001 || !loaded.rtl.empty()) {
+        std::cerr << "  ✗ FAIL: checkpoint fields differ\n";
+        return 1;
+    }
+    restore_golden(fresh, loaded);
+    if (run(fresh, 5000) != reference) {
+        std::cerr << "  ✗ FAIL: restored run differs\n";
+        return 1;
+    }
+    std::cout << "  ✓ next 5000 cycles identical\n\n";
+
+    // Test 2: a model image round trips
+    std::cout << "Test 2: Model image round trip\n";
+    checkpoint.rtl.assign(4096, 0);
+    for (size_t i = 0; i < checkpoint.rtl.size(); i++) {
+        checkpoint.rtl[i] = i * 7;
+    }
+    if (!write_checkpoint(path, checkpoint) || !read_checkpoint(path, loaded) || loaded.rtl != checkpoint.rtl) {
+        std::cerr << "  ✗ FAIL: model image differs\n";
+        return 1;
+    }
+    std::cout << "  ✓ 4096 bytes\n\n";
+
+    // Test 3: damaged files, including an image size past the end of the file
+    std::cout << "Test 3: Reject damaged checkpoints\n";
+    const std::vector<uint8_t> original = read_file(path);
+    const char* damages[] = { "truncated image", "truncated instruction memory", "huge rtl_size", "trailing bytes", "version" };
+    for (int d = 0; d < 5; d++) {
+        std::vector<uint8_t> damaged = original;
+        CheckpointHeader* header = reinterpret_cast<CheckpointHeader*>(damaged.data());
+        switch (d) {
+            case 0: damaged.resize(damaged.size() - 1); break;
+            case 1: damaged.resize(sizeof(CheckpointHeader) + 100); break;
+            case 2: header->rtl_size = 1ull << 60; break;
+            case 3: damaged.push_back(0); break;
+            case 4: header->version = 1; break;
+        }
+        write_file(path, damaged);
+        if (read_checkpoint(path, loaded)) {
+            std::cerr << "  ✗ FAIL: accepted a checkpoint with " << damages[d] << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ image size, length and version checked\n\n";
+
+    std::remove(path);
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Checkpoint / restore of a Vmain + sCPUMain pair: a restored run must reproduce the
+// original run cycle for cycle, from memory and from a file into a fresh Vmain.
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <verilated.h>
+#include "Vmain.h"
+#include "Vmain___024root.h"
+#include "checkpoint_verilated.h"
+#include "sCPU.h"
+
+typedef VerilatedAdapter<Vmain> DesignedAdapter;
+
+// Endless loop on which the RTL and golden CPU agree (r0 > r3 and r0 != r3)
+const uint8_t LOOP[] = {
+    0b10001111,  // 0: li r0, 15
+    0b10110001,  // 1: li r3, 1
+    0b00010111,  // 2: add r1, r1, r3
+    0b00101001,  // 3: add r2, r2, r1
+    0b11001011   // 4: bner0 r3, 2
+};
+
+void load_loop(Vmain& cpu, sCPUMain& golden) {
+    cpu.clk = 0;
+    cpu.reset = 0;
+    cpu.eval();     // initial block first, then replace its program
+    for (int i = 0; i < 16; i++) {
+        cpu.rootp->main__DOT__imem_inst__DOT__memory[i] = i < (int)sizeof(LOOP) ? LOOP[i] : 0;
+    }
+    golden.loadInstructions(LOOP, sizeof(LOOP));
+}
+
+// Packed states of both CPUs for cycles cycles
+std::vector<uint64_t> run(DesignedAdapter& designed, sCPUMain& golden, int cycles) {
+    GoldenAdapter<sCPUMain> golden_adapter(golden);
+    std::vector<uint64_t> states;
+    for (int i = 0; i < cycles; i++) {
+        designed.step();
+        golden_adapter.step();
+        states.push_back(designed.packedState());
+        states.push_back(golden_adapter.packedState());
+    }
+    return states;
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    std::cout << "Testing checkpoint / restore\n";
+    std::cout << "============================\n\n";
+
+    const char* path = "checkpoint_test.ckpt";
+
+    Vmain cpu;
+    sCPUMain golden;
+    load_loop(cpu, golden);
+    DesignedAdapter designed(cpu);
+    designed.reset();
+    run(designed, golden, 1000);
+
+    Checkpoint checkpoint;
+    save_checkpoint(designed, golden, 1000, checkpoint);
+    uint64_t time = designed.time();
+    std::vector<uint64_t> reference = run(designed, golden, 5000);
+
+    // Test 1: in-memory snapshot, restored into the same models
+    std::cout << "Test 1: In-memory checkpoint at cycle 1000\n";
+    uint64_t cycle = restore_checkpoint(designed, golden, checkpoint);
+    if (cycle != 1000 || designed.time() != time || run(designed, golden, 5000) != reference) {
+        std::cerr << "  ✗ FAIL: restored run differs\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << checkpoint.rtl.size() << " byte model image, next 5000 cycles identical\n\n";
+
+    // Test 2: file snapshot, restored into fresh models (as in a new process)
+    std::cout << "Test 2: File checkpoint into a fresh Vmain and sCPUMain\n";
+    if (!write_checkpoint(path, checkpoint)) {
+        return 1;
+    }
+    {
+        Checkpoint loaded;
+        if (!read_checkpoint(path, loaded)) {
+            return 1;
+        }
+        std::unique_ptr<Vmain> fresh_cpu(new Vmain);
+        sCPUMain fresh_golden;
+        DesignedAdapter fresh(*fresh_cpu);
+        if (restore_checkpoint(fresh, fresh_golden, loaded) != 1000
+            || run(fresh, fresh_golden, 5000) != reference) {
+            std::cerr << "  ✗ FAIL: run restored from " << path << " differs\n";
+            return 1;
+        }
+        fresh_cpu->final();
+    }
+    std::cout << "  ✓ Next 5000 cycles identical\n\n";
+
+    // Test 3: golden-only checkpoint (no model image) round trip
+    std::cout << "Test 3: Golden-only checkpoint\n";
+    {
+        sCPUMain source;
+        source.loadInstructions(LOOP, sizeof(LOOP));
+        uint8_t written_reg, written_value;
+        for (int i = 0; i < 77; i++) {
+            source.executeInstruction(written_reg, written_value);
+        }
+        Checkpoint golden_only;
+        golden_only.cycle = 77;
+        golden_only.time = 0;
+        save_golden(source, golden_only);
+        Checkpoint loaded;
+        sCPUMain restored;
+        if (!write_checkpoint(path, golden_only) || !read_checkpoint(path, loaded) || !loaded.rtl.empty()) {
+            std::cerr << "  ✗ FAIL: file round trip\n";
+            return 1;
+        }
+        restore_golden(restored, loaded);
+        for (int i = 0; i < 100; i++) {
+            if (restored.getPackedState() != source.getPackedState()) {
+                std::cerr << "  ✗ FAIL: golden state differs " << i << " steps after restore\n";
+                return 1;
+            }
+            source.executeInstruction(written_reg, written_value);
+            restored.executeInstruction(written_reg, written_value);
+        }
+    }
+    std::cout << "  ✓ State and program restored\n\n";
+
+    std::remove(path);
+    cpu.final();
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,20 @@
+g++ -O2 -std=c++17 checkpoint_golden_test.cpp checkpoint.cpp sCPU.cpp -o checkpoint_golden_test
+./checkpoint_golden_test
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe checkpoint_test.cpp checkpoint.cpp sCPU.cpp \
+  --savable \
+  -CFLAGS "-O2"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain
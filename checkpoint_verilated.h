@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <verilated.h>
+#include <verilated_save.h>
+#include "checkpoint.h"
+#include "lockstep_verilated.h"
+
+// Verilator serialization of a model built with --savable into a byte vector, instead of
+// the file of VerilatedSave, so checkpoints can also be kept in memory
+class VerilatedMemorySave : public VerilatedSerialize {
+    public:
+        explicit VerilatedMemorySave(std::vector<uint8_t>& bytes) : bytes_(bytes) {
+            this->bytes_.clear();
+            this->m_isOpen = true;
+            header();
+        }
+
+        ~VerilatedMemorySave() override {
+            close();
+        }
+
+        void close() override {
+            if (!this->m_isOpen) {
+                return;
+            }
+            trailer();
+            flush();
+            this->m_isOpen = false;
+        }
+
+        void flush() override {
+            this->bytes_.insert(this->bytes_.end(), this->m_bufp, this->m_cp);
+            this->m_cp = this->m_bufp;
+        }
+
+    private:
+        std::vector<uint8_t>& bytes_;
+};
+
+// Counterpart of VerilatedMemorySave (as VerilatedRestore, reading from the vector)
+class VerilatedMemoryRestore : public VerilatedDeserialize {
+    public:
+        explicit VerilatedMemoryRestore(const std::vector<uint8_t>& bytes) : bytes_(bytes), offset_(0) {
+            this->m_isOpen = true;
+            this->m_cp = this->m_bufp;
+            this->m_endp = this->m_bufp;
+            header();
+        }
+
+        ~VerilatedMemoryRestore() override {
+            close();
+        }
+
+        void close() override {
+            if (!this->m_isOpen) {
+                return;
+            }
+            trailer();
+            this->m_isOpen = false;
+        }
+
+        // Keep the unread bytes, then top the buffer up from the vector
+        void fill() override {
+            size_t unread = this->m_endp - this->m_cp;
+            std::memmove(this->m_bufp, this->m_cp, unread);
+            this->m_cp = this->m_bufp;
+            this->m_endp = this->m_bufp + unread;
+            size_t count = std::min(bufferSize() - unread, this->bytes_.size() - this->offset_);
+            std::memcpy(this->m_endp, this->bytes_.data() + this->offset_, count);
+            this->m_endp += count;
+            this->offset_ += count;
+        }
+
+    private:
+        const std::vector<uint8_t>& bytes_;
+        size_t offset_;
+};
+
+// Snapshot of a designed / golden pair at harness cycle cycle
+template <typename VModel, typename Trace, typename CPU>
+void save_checkpoint(VerilatedAdapter<VModel, Trace>& designed, CPU& golden, uint64_t cycle, Checkpoint& checkpoint) {
+    checkpoint.cycle = cycle;
+    checkpoint.time = designed.time();
+    save_golden(golden, checkpoint);
+    VerilatedMemorySave os(checkpoint.rtl);
+    os << designed.model();
+}
+
+// Puts both models back into the checkpointed state; returns the harness cycle to continue at.
+// The Vmain may be a fresh instance (same --savable build) in another process.
+template <typename VModel, typename Trace, typename CPU>
+uint64_t restore_checkpoint(VerilatedAdapter<VModel, Trace>& designed, CPU& golden, const Checkpoint& checkpoint) {
+    {
+        VerilatedMemoryRestore is(checkpoint.rtl);
+        is >> designed.model();
+    }
+    designed.setTime(checkpoint.time);
+    restore_golden(golden, checkpoint);
+    return checkpoint.cycle;
+}
+
+// Checkpoints of a designed / golden pair as the Snapshots of Soak (soak.h)
+template <typename VModel, typename Trace, typename CPU>
+class VerilatedSnapshots {
+    public:
+        typedef Checkpoint Snapshot;
+
+        VerilatedSnapshots(VerilatedAdapter<VModel, Trace>& designed, CPU& golden)
+            : designed_(designed), golden_(golden) {}
+
+        void save(uint64_t cycle, Checkpoint& checkpoint) {
+            save_checkpoint(this->designed_, this->golden_, cycle, checkpoint);
+        }
+
+        void restore(const Checkpoint& checkpoint) {
+            restore_checkpoint(this->designed_, this->golden_, checkpoint);
+        }
+
+    private:
+        VerilatedAdapter<VModel, Trace>& designed_;
+        CPU& golden_;
+};
@@ -0,0 +1,420 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "commitlog.h"
+
+// Records are flushed to disk in chunks of this size
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+// Largest encoded record: flags + 10-byte LEB128 skip + PC + value
+static const size_t MAX_RECORD_SIZE = 13;
+
+// Bytes per memcmp when searching for the first difference
+static const uint64_t COMPARE_BLOCK_SIZE = 1 << 16;
+
+// Same retired instruction (rd / value only count when written)
+bool same_commit(const CommitRecord& a, const CommitRecord& b) {
+    return a.cycle == b.cycle
+        && a.pc == b.pc
+        && a.written == b.written
+        && a.branch_taken == b.branch_taken
+        && (!a.written || (a.rd == b.rd && a.value == b.value));
+}
+
+// e.g. "cycle 5 pc 6 branch taken", "cycle 4 pc 5 r2 <- 15"
+std::string describe_commit(const CommitRecord& record) {
+    std::ostringstream text;
+    text << "cycle " << record.cycle << " pc " << (int)record.pc;
+    if (record.written) {
+        text << " r" << (int)record.rd << " <- " << (int)record.value;
+    }
+    if (record.branch_taken) {
+        text << " branch taken";
+    }
+    return text.str();
+}
+
+// ========== CommitLogWriter ==========
+
+CommitLogWriter::CommitLogWriter() {
+    this->file_ = nullptr;
+    std::memset(&this->header_, 0, sizeof(this->header_));
+    this->flushed_bytes_ = 0;
+    this->next_cycle_ = 0;
+    this->next_pc_ = 0;
+}
+
+CommitLogWriter::~CommitLogWriter() {
+    close();
+}
+
+bool CommitLogWriter::open(const std::string& path) {
+    close();
+
+    std::memset(&this->header_, 0, sizeof(this->header_));
+    std::memcpy(this->header_.magic, COMMIT_LOG_MAGIC, sizeof(COMMIT_LOG_MAGIC));
+    this->header_.version = COMMIT_LOG_VERSION;
+    this->header_.flags = COMMIT_LOG_HAS_INDEX;
+    this->next_cycle_ = 0;
+    this->next_pc_ = 0;
+    this->flushed_bytes_ = 0;
+    this->sync_points_.clear();
+
+    this->file_ = std::fopen(path.c_str(), "wb");
+    if (this->file_ == nullptr) {
+        std::cerr << "err Cannot write " << path << "\n";
+        return false;
+    }
+
+    // Header is written again with the final count by close()
+    this->buffer_.clear();
+    this->buffer_.reserve(WRITE_BUFFER_SIZE + MAX_RECORD_SIZE);
+    return std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1;
+}
+
+bool CommitLogWriter::append(const CommitRecord& record) {
+    if (this->file_ == nullptr) {
+        return false;
+    }
+
+    // Decoder state at this record, so readers can start decoding here
+    if (this->header_.record_count % COMMIT_LOG_SYNC_INTERVAL == 0) {
+        CommitLogSyncPoint point = {};
+        point.record = this->header_.record_count;
+        point.offset = this->flushed_bytes_ + this->buffer_.size();
+        point.next_cycle = this->next_cycle_;
+        point.next_pc = this->next_pc_;
+        this->sync_points_.push_back(point);
+    }
+
+    uint8_t flags = 0;
+    if (record.written) {
+        flags |= COMMIT_WRITE | ((record.rd & 3) << COMMIT_RD_SHIFT);
+    }
+    if (record.branch_taken) {
+        flags |= COMMIT_BRANCH_TAKEN;
+    }
+    if (record.pc != this->next_pc_) {
+        flags |= COMMIT_PC_JUMP;
+    }
+    if (record.cycle != this->next_cycle_) {
+        flags |= COMMIT_CYCLE_SKIP;
+    }
+
+    this->buffer_.push_back(flags);
+    if (flags & COMMIT_CYCLE_SKIP) {
+        uint64_t skip = record.cycle - this->next_cycle_;
+        do {
+            uint8_t byte = skip & 0x7F;
+            skip >>= 7;
+            this->buffer_.push_back(skip != 0 ? (byte | 0x80) : byte);
+        } while (skip != 0);
+    }
+    if (flags & COMMIT_PC_JUMP) {
+        this->buffer_.push_back(record.pc);
+    }
+    if (flags & COMMIT_WRITE) {
+        this->buffer_.push_back(record.value);
+    }
+
+    this->next_cycle_ = record.cycle + 1;
+    this->next_pc_ = record.pc + 1;
+    this->header_.record_count++;
+
+    if (this->buffer_.size() >= WRITE_BUFFER_SIZE) {
+        return flushBuffer();
+    }
+    return true;
+}
+
+bool CommitLogWriter::flushBuffer() {
+    bool ok = this->buffer_.empty()
+           || std::fwrite(this->buffer_.data(), this->buffer_.size(), 1, this->file_) == 1;
+    this->flushed_bytes_ += this->buffer_.size();
+    this->buffer_.clear();
+    return ok;
+}
+
+bool CommitLogWriter::close() {
+    if (this->file_ == nullptr) {
+        return true;
+    }
+
+    // Sync point index directly follows the records
+    bool ok = flushBuffer();
+    this->header_.index_offset = sizeof(CommitLogHeader) + this->flushed_bytes_;
+    ok = ok && (this->sync_points_.empty()
+                || std::fwrite(this->sync_points_.data(), sizeof(CommitLogSyncPoint), this->sync_points_.size(), this->file_)
+                   == this->sync_points_.size());
+    ok = ok && std::fseek(this->file_, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1;
+    ok = (std::fclose(this->file_) == 0) && ok;
+    this->file_ = nullptr;
+    return ok;
+}
+
+// ========== CommitLogReader ==========
+
+CommitLogReader::CommitLogReader() {
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+    this->records_ = nullptr;
+    this->cursor_ = nullptr;
+    this->end_ = nullptr;
+    this->records_read_ = 0;
+    this->next_cycle_ = 0;
+    this->next_pc_ = 0;
+}
+
+CommitLogReader::~CommitLogReader() {
+    close();
+}
+
+bool CommitLogReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CommitLogHeader)) {
+        std::cerr << "err " << path << " is too small to be a commit log\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "err Cannot map " << path << "\n";
+        return false;
+    }
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+    const CommitLogHeader* header = static_cast<const CommitLogHeader*>(mapping);
+    // Version 1 logs have no sync point index
+    bool has_index = header->version >= 2 && (header->flags & COMMIT_LOG_HAS_INDEX);
+    bool valid = std::memcmp(header->magic, COMMIT_LOG_MAGIC, sizeof(COMMIT_LOG_MAGIC)) == 0
+              && (header->version == 1 || header->version == COMMIT_LOG_VERSION)
+              && (!has_index || (header->index_offset >= sizeof(CommitLogHeader)
+                                 && header->index_offset <= (uint64_t)info.st_size
+                                 && (info.st_size - header->index_offset) % sizeof(CommitLogSyncPoint) == 0));
+    if (!valid) {
+        std::cerr << "err " << path << " is not a valid commit log (version " << COMMIT_LOG_VERSION << ")\n";
+        munmap(mapping, info.st_size);
+        return false;
+    }
+
+    this->mapping_ = mapping;
+    this->mapping_size_ = info.st_size;
+    this->header_ = header;
+    this->records_ = static_cast<const uint8_t*>(mapping) + sizeof(CommitLogHeader);
+    if (has_index) {
+        this->end_ = static_cast<const uint8_t*>(mapping) + header->index_offset;
+        // Not aligned in the file, copied out (one entry per COMMIT_LOG_SYNC_INTERVAL records)
+        this->sync_points_.resize((info.st_size - header->index_offset) / sizeof(CommitLogSyncPoint));
+        if (!this->sync_points_.empty()) {
+            std::memcpy(this->sync_points_.data(), this->end_, this->sync_points_.size() * sizeof(CommitLogSyncPoint));
+        }
+    } else {
+        this->end_ = static_cast<const uint8_t*>(mapping) + info.st_size;
+    }
+    rewind();
+    return true;
+}
+
+void CommitLogReader::close() {
+    if (this->mapping_ != nullptr) {
+        munmap(this->mapping_, this->mapping_size_);
+    }
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+    this->records_ = nullptr;
+    this->cursor_ = nullptr;
+    this->end_ = nullptr;
+    this->sync_points_.clear();
+}
+
+uint64_t CommitLogReader::size() {
+    return this->header_ != nullptr ? this->header_->record_count : 0;
+}
+
+void CommitLogReader::rewind() {
+    this->cursor_ = this->records_;
+    this->records_read_ = 0;
+    this->next_cycle_ = 0;
+    this->next_pc_ = 0;
+}
+
+void CommitLogReader::seek(const CommitLogSyncPoint& point) {
+    if (this->records_ == nullptr || point.offset > (uint64_t)(this->end_ - this->records_)) {
+        return;
+    }
+    this->cursor_ = this->records_ + point.offset;
+    this->records_read_ = point.record;
+    this->next_cycle_ = point.next_cycle;
+    this->next_pc_ = point.next_pc;
+}
+
+bool CommitLogReader::seekRecord(uint64_t index) {
+    if (index > size()) {
+        return false;
+    }
+
+    // Last sync point at or before index
+    auto point = std::upper_bound(
+        this->sync_points_.begin(), this->sync_points_.end(), index,
+        [](uint64_t record, const CommitLogSyncPoint& p) { return record < p.record; });
+    if (point != this->sync_points_.begin()) {
+        seek(*(point - 1));
+    } else {
+        rewind();
+    }
+
+    CommitRecord record;
+    while (this->records_read_ < index) {
+        if (!next(record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const uint8_t* CommitLogReader::records() {
+    return this->records_;
+}
+
+uint64_t CommitLogReader::recordBytes() {
+    return this->records_ != nullptr ? this->end_ - this->records_ : 0;
+}
+
+const std::vector<CommitLogSyncPoint>& CommitLogReader::syncPoints() {
+    return this->sync_points_;
+}
+
+bool CommitLogReader::next(CommitRecord& record) {
+    if (this->header_ == nullptr || this->records_read_ >= this->header_->record_count) {
+        return false;
+    }
+
+    const uint8_t* p = this->cursor_;
+    if (p >= this->end_) {
+        std::cerr << "err Commit log truncated at record " << this->records_read_ << "\n";
+        return false;
+    }
+    uint8_t flags = *p++;
+
+    uint64_t skip = 0;
+    if (flags & COMMIT_CYCLE_SKIP) {
+        int shift = 0;
+        uint8_t byte;
+        do {
+            if (p >= this->end_ || shift > 63) {
+                std::cerr << "err Commit log truncated at record " << this->records_read_ << "\n";
+                return false;
+            }
+            byte = *p++;
+            skip |= (uint64_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+    }
+
+    int tail = ((flags & COMMIT_PC_JUMP) ? 1 : 0) + ((flags & COMMIT_WRITE) ? 1 : 0);
+    if (this->end_ - p < tail) {
+        std::cerr << "err Commit log truncated at record " << this->records_read_ << "\n";
+        return false;
+    }
+
+    record.cycle = this->next_cycle_ + skip;
+    record.pc = (flags & COMMIT_PC_JUMP) ? *p++ : this->next_pc_;
+    record.written = (flags & COMMIT_WRITE) != 0;
+    record.rd = record.written ? (flags >> COMMIT_RD_SHIFT) & 3 : 0;
+    record.value = record.written ? *p++ : 0;
+    record.branch_taken = (flags & COMMIT_BRANCH_TAKEN) != 0;
+
+    this->cursor_ = p;
+    this->records_read_++;
+    this->next_cycle_ = record.cycle + 1;
+    this->next_pc_ = record.pc + 1;
+    return true;
+}
+
+// ========== Comparison ==========
+
+uint64_t first_difference(const uint8_t* a, const uint8_t* b, uint64_t size) {
+    uint64_t offset = 0;
+    while (offset < size) {
+        uint64_t block_end = std::min(offset + COMPARE_BLOCK_SIZE, size);
+        if (std::memcmp(a + offset, b + offset, block_end - offset) != 0) {
+            // Narrow down inside the block: 8-byte words, then bytes
+            uint64_t word_a, word_b;
+            while (offset + 8 <= block_end) {
+                std::memcpy(&word_a, a + offset, 8);
+                std::memcpy(&word_b, b + offset, 8);
+                if (word_a != word_b) {
+                    break;
+                }
+                offset += 8;
+            }
+            while (offset < block_end && a[offset] == b[offset]) {
+                offset++;
+            }
+            return offset;
+        }
+        offset = block_end;
+    }
+    return size;
+}
+
+bool compare_commit_logs(CommitLogReader& a, CommitLogReader& b, CommitDivergence& divergence) {
+    uint64_t common_bytes = std::min(a.recordBytes(), b.recordBytes());
+    uint64_t difference = first_difference(a.records(), b.records(), common_bytes);
+    if (difference == common_bytes && a.recordBytes() == b.recordBytes() && a.size() == b.size()) {
+        a.seekRecord(a.size());
+        b.seekRecord(b.size());
+        return true;
+    }
+
+    // Records before the first differing byte are identical in both logs, and so is the
+    // decoder state at any sync point of a that starts before it
+    a.rewind();
+    b.rewind();
+    uint64_t index = 0;
+    const std::vector<CommitLogSyncPoint>& points = a.syncPoints();
+    auto point = std::lower_bound(
+        points.begin(), points.end(), difference,
+        [](const CommitLogSyncPoint& p, uint64_t offset) { return p.offset < offset; });
+    if (point != points.begin()) {
+        point--;
+        a.seek(*point);
+        b.seek(*point);
+        index = point->record;
+    }
+
+    for (; ; index++) {
+        bool has_a = a.next(divergence.a);
+        bool has_b = b.next(divergence.b);
+        if (!has_a && !has_b) {
+            return true;
+        }
+        if (has_a != has_b || !same_commit(divergence.a, divergence.b)) {
+            divergence.index = index;
+            divergence.has_a = has_a;
+            divergence.has_b = has_b;
+            return false;
+        }
+    }
+}
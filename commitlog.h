@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Binary commit log: one record per retired instruction, written by either model on its
+// own and compared offline (commitlog_compare), so the RTL run and the golden run do not
+// have to be clocked together.
+//
+// Layout (little-endian):
+//   CommitLogHeader (32 bytes)
+//   record_count delta-encoded records:
+//     flags byte (COMMIT_*)
+//     cycle skip (LEB128) if COMMIT_CYCLE_SKIP: cycle - (previous cycle + 1)
+//     PC byte               if COMMIT_PC_JUMP:   PC != previous PC + 1
+//     written value byte    if COMMIT_WRITE
+//   then the sync point index (version 2, COMMIT_LOG_HAS_INDEX):
+//   CommitLogSyncPoint entries up to the end of the file, one every COMMIT_LOG_SYNC_INTERVAL records
+// A straight-line instruction that writes a register costs 2 bytes, a branch 1-2 bytes.
+// The encoding is deterministic, so logs with the same records are byte-identical up to
+// their first differing record: comparison is a block memcmp, decoding starts at the last
+// sync point before the first differing byte.
+
+const char COMMIT_LOG_MAGIC[8] = { 's', 'I', 'S', 'A', 'C', 'L', 'O', 'G' };
+const uint32_t COMMIT_LOG_VERSION = 2;
+
+// CommitLogHeader::flags
+const uint32_t COMMIT_LOG_HAS_INDEX = 1;
+
+// Records between two sync points
+const uint64_t COMMIT_LOG_SYNC_INTERVAL = 1 << 16;
+
+// Record flags byte
+const uint8_t COMMIT_WRITE = 1 << 0;          // a register was written
+const uint8_t COMMIT_RD_SHIFT = 1;            // bits 2:1 written register
+const uint8_t COMMIT_BRANCH_TAKEN = 1 << 3;
+const uint8_t COMMIT_PC_JUMP = 1 << 4;        // explicit PC byte follows
+const uint8_t COMMIT_CYCLE_SKIP = 1 << 5;     // explicit cycle skip follows
+
+struct CommitLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;             // COMMIT_LOG_HAS_INDEX
+    uint64_t record_count;
+    uint64_t index_offset;      // file offset of the sync point index (version 2)
+};
+static_assert(sizeof(CommitLogHeader) == 32, "commit log header must stay 32 bytes");
+
+// Decoder state before record `record`, which starts at byte `offset` of the record area
+struct CommitLogSyncPoint {
+    uint64_t record;
+    uint64_t offset;
+    uint64_t next_cycle;
+    uint8_t next_pc;
+    uint8_t reserved[7];
+};
+static_assert(sizeof(CommitLogSyncPoint) == 32, "commit log sync point must stay 32 bytes");
+
+// One retired instruction
+struct CommitRecord {
+    uint64_t cycle;             // clock cycle the instruction retired in
+    uint8_t pc;                 // address of the instruction
+    bool written;               // a register was written
+    uint8_t rd;                 // written register (if written)
+    uint8_t value;              // written value (if written)
+    bool branch_taken;
+};
+
+// Same retired instruction (rd / value only count when written)
+bool same_commit(const CommitRecord& a, const CommitRecord& b);
+
+// e.g. "cycle 5 pc 6 branch taken", "cycle 4 pc 5 r2 <- 15"
+std::string describe_commit(const CommitRecord& record);
+
+// Appends records through a buffered writer; close() patches the record count
+class CommitLogWriter {
+    public:
+        CommitLogWriter();
+        ~CommitLogWriter();
+
+        bool open(const std::string& path);
+        bool append(const CommitRecord& record);
+        bool close();
+
+    private:
+        bool flushBuffer();
+
+        FILE* file_;
+        CommitLogHeader header_;
+        std::vector<uint8_t> buffer_;
+        uint64_t flushed_bytes_;
+        std::vector<CommitLogSyncPoint> sync_points_;
+
+        // Delta predictors: next record is expected at next_cycle_ / next_pc_
+        uint64_t next_cycle_;
+        uint8_t next_pc_;
+};
+
+// Sequential decoder over a memory-mapped commit log
+class CommitLogReader {
+    public:
+        CommitLogReader();
+        ~CommitLogReader();
+
+        // Maps the file and validates the header
+        bool open(const std::string& path);
+        void close();
+
+        uint64_t size();
+
+        // Decode the next record; false at the end of the log (or on a truncated record)
+        bool next(CommitRecord& record);
+
+        // Back to the first record
+        void rewind();
+
+        // Continue decoding at a sync point (of this log, or of a log with the same prefix)
+        void seek(const CommitLogSyncPoint& point);
+
+        // Position at record index (nearest sync point, then decode forward)
+        bool seekRecord(uint64_t index);
+
+        // Raw encoded record area
+        const uint8_t* records();
+        uint64_t recordBytes();
+
+        // Sync point index (empty for version 1 logs)
+        const std::vector<CommitLogSyncPoint>& syncPoints();
+
+    private:
+        void* mapping_;
+        size_t mapping_size_;
+        const CommitLogHeader* header_;
+        const uint8_t* records_;
+        const uint8_t* cursor_;
+        const uint8_t* end_;
+        std::vector<CommitLogSyncPoint> sync_points_;
+        uint64_t records_read_;
+
+        uint64_t next_cycle_;
+        uint8_t next_pc_;
+};
+
+// First point where two logs disagree
+struct CommitDivergence {
+    uint64_t index;             // record index
+    bool has_a, has_b;          // false if that log already ended
+    CommitRecord a, b;
+};
+
+// Offset of the first differing byte of a and b (size if none): memcmp over large
+// blocks, then word compares inside the differing block
+uint64_t first_difference(const uint8_t* a, const uint8_t* b, uint64_t size);
+
+// Compares two logs; returns true if identical, otherwise fills divergence with the first
+// differing record. Identical prefixes are skipped with a block compare of the encoded
+// bytes; only records after the last sync point before the first differing byte are decoded.
+// Leaves both readers positioned after the divergent records.
+bool compare_commit_logs(CommitLogReader& a, CommitLogReader& b, CommitDivergence& divergence);
@@ -0,0 +1,89 @@
+// Runs the designed CPU (Vmain) on its own and writes its commit log (see commitlog.h),
+// to be checked offline against a golden log with commitlog_compare.
+// The program is the one in instruction_memory.sv, or the random program of a campaign
+// seed; it runs until the CPU halts or the cycle cap.
+//
+// Usage:
+//   ./obj_dir/Vmain <output.clog> [--seed=S] [--cycles=C]
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <verilated.h>
+#include "Vmain.h"
+#include "Vmain___024root.h"
+#include "campaign.h"
+#include "commitlog.h"
+#include "lockstep_verilated.h"
+#include "options.h"
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    std::string output_path;
+    uint64_t seed = 0;
+    bool random_program = false;
+    uint64_t max_cycles = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string arg = argv[i];
+        if (parse_option(arg, "seed", value)) {
+            seed = value;
+            random_program = true;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_cycles = value;
+        } else if (unknown_option(arg)) {
+            return 1;
+        } else if (arg[0] != '+') {
+            output_path = arg;
+        }
+    }
+    if (output_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <output.clog> [--seed=S] [--cycles=C]\n";
+        return 1;
+    }
+
+    Vmain* designed_cpu = new Vmain;
+    designed_cpu->clk = 0;
+    designed_cpu->reset = 0;
+    designed_cpu->eval();   // runs the initial block
+
+    // Program end (address after the last non-zero instruction) of the ROM in use
+    std::vector<uint8_t> program(ROM_SIZE);
+    if (random_program) {
+        program = generate_program(seed, ROM_SIZE);
+        load_rom(designed_cpu, program.data(), ROM_SIZE);
+    } else {
+        for (int i = 0; i < ROM_SIZE; i++) {
+            program[i] = designed_cpu->rootp->main__DOT__imem_inst__DOT__memory[i];
+        }
+    }
+    VerilatedAdapter<Vmain> designed(*designed_cpu);
+    designed.reset();
+
+    CommitLogWriter writer;
+    if (!writer.open(output_path)) {
+        return 1;
+    }
+
+    CommitRecord record;
+    uint64_t cycle = 0;
+    for (; cycle < max_cycles && !designed.halted(); cycle++) {
+        designed.commit(record);
+        record.cycle = cycle;
+        writer.append(record);
+    }
+    if (!writer.close()) {
+        std::cerr << "err Cannot finish " << output_path << "\n";
+        return 1;
+    }
+
+    std::cout << "ok Designed CPU retired " << cycle << " instructions"
+              << (designed.halted() ? " (halted)" : " (cycle cap)") << ", log: " << output_path << "\n";
+
+    designed_cpu->final();
+    delete designed_cpu;
+    return 0;
+}
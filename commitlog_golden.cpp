@@ -0,0 +1,83 @@
+// Runs the golden CPU (sCPU) on its own and writes its commit log (see commitlog.h).
+// The program is the example program of instruction_memory.sv, or the random program of
+// a campaign seed; it runs until the CPU halts or the cycle cap.
+//
+// Usage:
+//   ./commitlog_golden <output.clog> [--seed=S] [--cycles=C]
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "commitlog.h"
+#include "corpus.h"
+#include "lockstep.h"
+#include "options.h"
+#include "sCPU.h"
+
+int main(int argc, char** argv) {
+    std::string output_path;
+    uint64_t seed = 0;
+    bool random_program = false;
+    uint64_t max_cycles = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string arg = argv[i];
+        if (parse_option(arg, "seed", value)) {
+            seed = value;
+            random_program = true;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_cycles = value;
+        } else if (unknown_option(arg)) {
+            return 1;
+        } else {
+            output_path = arg;
+        }
+    }
+    if (output_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <output.clog> [--seed=S] [--cycles=C]\n";
+        return 1;
+    }
+
+    // Same as in instruction_memory.sv
+    std::vector<uint8_t> program = {
+        0b10001010,  // 0: li r0, 10
+        0b10010000,  // 1: li r1, 0
+        0b10100000,  // 2: li r2, 0
+        0b10110001,  // 3: li r3, 1
+        0b00010111,  // 4: add r1, r1, r3
+        0b00101001,  // 5: add r2, r2, r1
+        0b11010001,  // 6: bner0 r1, 4
+        0b11011111   // 7: bner0 r3, 7
+    };
+    if (random_program) {
+        program = generate_program(seed, 16);
+    }
+
+    // Sized like main.sv: the PC wraps from 15 to 0 as in the designed CPU's log
+    sCPUMain golden_cpu;
+    golden_cpu.loadInstructions(program);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+
+    CommitLogWriter writer;
+    if (!writer.open(output_path)) {
+        return 1;
+    }
+
+    CommitRecord record;
+    uint64_t cycle = 0;
+    for (; cycle < max_cycles && !golden.halted(); cycle++) {
+        golden.commit(record);
+        record.cycle = cycle;
+        writer.append(record);
+    }
+    if (!writer.close()) {
+        std::cerr << "err Cannot finish " << output_path << "\n";
+        return 1;
+    }
+
+    std::cout << "ok Golden CPU retired " << cycle << " instructions"
+              << (golden.halted() ? " (halted)" : " (cycle cap)") << ", log: " << output_path << "\n";
+    return 0;
+}
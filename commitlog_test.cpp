@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "commitlog.h"
+#include "lockstep.h"
+#include "sCPU.h"
+
+int main() {
+    std::cout << "Testing Commit Log (write, mmap read back, offline compare)\n";
+    std::cout << "===========================================================\n\n";
+
+    const char* path_a = "commitlog_test_a.clog";
+    const char* path_b = "commitlog_test_b.clog";
+
+    // Test 1: round trip, including cycle skips and PC jumps
+    std::cout << "Test 1: Round trip of 100000 records\n";
+    std::mt19937_64 rng(1);
+    std::vector<CommitRecord> records;
+    uint64_t cycle = 0;
+    uint8_t pc = 0;
+    for (int i = 0; i < 100000; i++) {
+        CommitRecord record = {};
+        cycle += (rng() % 8 == 0) ? 1 + rng() % 100000 : 1;
+        pc = (rng() % 4 == 0) ? rng() & 0xFF : pc + 1;
+        record.cycle = cycle;
+        record.pc = pc;
+        record.written = rng() & 1;
+        record.rd = record.written ? rng() & 3 : 0;
+        record.value = record.written ? rng() & 0xFF : 0;
+        record.branch_taken = !record.written && (rng() & 1);
+        records.push_back(record);
+    }
+    CommitLogWriter writer;
+    writer.open(path_a);
+    for (const CommitRecord& record : records) {
+        writer.append(record);
+    }
+    if (!writer.close()) {
+        std::cerr << "  ✗ FAIL: close failed\n";
+        return 1;
+    }
+    CommitLogReader reader;
+    if (!reader.open(path_a) || reader.size() != records.size()) {
+        std::cerr << "  ✗ FAIL: header mismatch, size " << reader.size() << "\n";
+        return 1;
+    }
+    CommitRecord record;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!reader.next(record) || !same_commit(record, records[i])) {
+            std::cerr << "  ✗ FAIL: record " << i << " differs: " << describe_commit(record) << "\n";
+            return 1;
+        }
+    }
+    if (reader.next(record)) {
+        std::cerr << "  ✗ FAIL: record past the end\n";
+        return 1;
+    }
+    reader.close();
+    std::cout << "  ✓ All records match\n\n";
+
+    // Test 2: golden run of the example program, straight-line records stay compact
+    std::cout << "Test 2: Golden log of the example program\n";
+    std::vector<uint8_t> program = { 0x8A, 0x90, 0xA0, 0xB1, 0x17, 0x29, 0xD1, 0xDF };
+    sCPU golden_cpu;
+    golden_cpu.loadInstructions(program);
+    GoldenAdapter<sCPU> golden(golden_cpu);
+    writer.open(path_a);
+    int branches_taken = 0;
+    for (cycle = 0; cycle < 1000 && !golden.halted(); cycle++) {
+        golden.commit(record);
+        record.cycle = cycle;
+        branches_taken += record.branch_taken;
+        writer.append(record);
+    }
+    writer.close();
+    reader.open(path_a);
+    long bytes = reader.recordBytes();
+    reader.close();
+    if (golden_cpu.getRegister(2) != 55 || branches_taken != 9 || bytes > (long)cycle * 2) {
+        std::cerr << "  ✗ FAIL: r2 " << (int)golden_cpu.getRegister(2) << ", " << branches_taken
+                  << " branches taken, " << bytes << " bytes for " << cycle << " records\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << cycle << " records in " << bytes << " bytes\n\n";
+
+    // Test 3: identical logs compare equal, first divergence is found
+    std::cout << "Test 3: Offline comparison\n";
+    CommitLogReader golden_log, other_log;
+    golden_log.open(path_a);
+    writer.open(path_b);
+    for (uint64_t i = 0; golden_log.next(record); i++) {
+        if (i == 20) {
+            record.value++;
+        }
+        writer.append(record);
+    }
+    writer.close();
+    other_log.open(path_b);
+    CommitDivergence divergence;
+    CommitLogReader golden_copy;
+    golden_copy.open(path_a);
+    if (!compare_commit_logs(golden_log, golden_copy, divergence)) {
+        std::cerr << "  ✗ FAIL: log differs from itself at record " << divergence.index << "\n";
+        return 1;
+    }
+    if (compare_commit_logs(other_log, golden_log, divergence) || divergence.index != 20
+        || divergence.a.value != divergence.b.value + 1) {
+        std::cerr << "  ✗ FAIL: divergence not found at record 20\n";
+        return 1;
+    }
+    std::cout << "  ✓ Divergence at record " << divergence.index << ": " << describe_commit(divergence.a)
+              << " vs " << describe_commit(divergence.b) << "\n\n";
+
+    // Test 4: a log that ends early diverges
+    std::cout << "Test 4: Shorter log\n";
+    golden_log.rewind();
+    writer.open(path_b);
+    for (int i = 0; i < 10 && golden_log.next(record); i++) {
+        writer.append(record);
+    }
+    writer.close();
+    other_log.open(path_b);
+    if (compare_commit_logs(other_log, golden_log, divergence) || divergence.index != 10
+        || divergence.has_a || !divergence.has_b) {
+        std::cerr << "  ✗ FAIL: early end not reported\n";
+        return 1;
+    }
+    std::cout << "  ✓ End of log reported at record " << divergence.index << "\n\n";
+
+    // Test 5: deep divergence in long logs, found by block compare + sync points
+    std::cout << "Test 5: Divergence deep inside long logs\n";
+    const uint64_t long_count = 3000000;
+    const uint64_t diverging = 2345678;
+    for (int log = 0; log < 2; log++) {
+        writer.open(log == 0 ? path_a : path_b);
+        for (uint64_t i = 0; i < long_count; i++) {
+            record = records[i % records.size()];
+            record.cycle = i + (i / 1000);
+            if (log == 1 && i == diverging) {
+                record.branch_taken = !record.branch_taken;
+            }
+            writer.append(record);
+        }
+        writer.close();
+    }
+    golden_log.open(path_a);
+    other_log.open(path_b);
+    if (golden_log.syncPoints().size() != (long_count + COMMIT_LOG_SYNC_INTERVAL - 1) / COMMIT_LOG_SYNC_INTERVAL
+        || compare_commit_logs(golden_log, other_log, divergence) || divergence.index != diverging
+        || divergence.a.cycle != diverging + diverging / 1000 || divergence.a.branch_taken == divergence.b.branch_taken) {
+        std::cerr << "  ✗ FAIL: divergence at record " << divergence.index << ", expected " << diverging << "\n";
+        return 1;
+    }
+    if (!golden_log.seekRecord(diverging) || !golden_log.next(record) || !same_commit(record, divergence.a)) {
+        std::cerr << "  ✗ FAIL: seekRecord lands on the wrong record\n";
+        return 1;
+    }
+    std::cout << "  ✓ Divergence at record " << divergence.index << " of " << long_count << "\n\n";
+
+    golden_log.close();
+    golden_copy.close();
+    other_log.close();
+    std::remove(path_a);
+    std::remove(path_b);
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
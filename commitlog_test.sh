@@ -0,0 +1,26 @@
+g++ -O2 -std=c++17 commitlog_test.cpp commitlog.cpp sCPU.cpp -o commitlog_test
+./commitlog_test
+
+# Offline flow: designed and golden CPU each write a log, compared afterwards
+g++ -O2 -std=c++17 commitlog_golden.cpp commitlog.cpp corpus.cpp sCPU.cpp -o commitlog_golden
+g++ -O2 -std=c++17 commitlog_compare.cpp commitlog.cpp -o commitlog_compare
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe commitlog_designed.cpp commitlog.cpp campaign.cpp corpus.cpp sCPU.cpp \
+  --trace \
+  -CFLAGS "-O2"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain designed.clog
+./commitlog_golden golden.clog
+./commitlog_compare designed.clog golden.clog
@@ -1,28 +1,34 @@
-module control_unit(
-    input logic [7:0] instruction,
+module control_unit #(
+    parameter REG_BITS = 2,    // register index width
+    parameter FIELD_WIDTH = 4, // immediate / branch address width, at least 2 * REG_BITS
+    localparam INSTR_WIDTH = 2 + REG_BITS + FIELD_WIDTH
+)(
+    input logic [INSTR_WIDTH-1:0] instruction,
 
     output logic [1:0] opcode,
-    output logic [1:0] rd,
-    output logic [1:0] rs1,
-    output logic [1:0] rs2,
-    output logic [3:0] addr,
-    output logic [3:0] imm
+    output logic [REG_BITS-1:0] rd,
+    output logic [REG_BITS-1:0] rs1,
+    output logic [REG_BITS-1:0] rs2,
+    output logic [FIELD_WIDTH-1:0] addr,
+    output logic [FIELD_WIDTH-1:0] imm
 );
     
     // Extract all fields first (constant slices outside always_comb)
+    // Default layout (REG_BITS 2, FIELD_WIDTH 4): opcode 7:6, rd 5:4, rs1 3:2, rs2 1:0,
+    // addr 5:2, imm 3:0
     logic [1:0] instr_opcode;
-    logic [1:0] instr_rd;
-    logic [1:0] instr_rs1;
-    logic [1:0] instr_rs2;
-    logic [3:0] instr_addr;
-    logic [3:0] instr_imm;
+    logic [REG_BITS-1:0] instr_rd;
+    logic [REG_BITS-1:0] instr_rs1;
+    logic [REG_BITS-1:0] instr_rs2;
+    logic [FIELD_WIDTH-1:0] instr_addr;
+    logic [FIELD_WIDTH-1:0] instr_imm;
     
-    assign instr_opcode = instruction[7:6];
-    assign instr_rd = instruction[5:4];
-    assign instr_rs1 = instruction[3:2];
-    assign instr_rs2 = instruction[1:0];
-    assign instr_addr = instruction[5:2];
-    assign instr_imm = instruction[3:0];
+    assign instr_opcode = instruction[INSTR_WIDTH-1:INSTR_WIDTH-2];
+    assign instr_rd = instruction[INSTR_WIDTH-3:FIELD_WIDTH];
+    assign instr_rs1 = instruction[2*REG_BITS-1:REG_BITS];
+    assign instr_rs2 = instruction[REG_BITS-1:0];
+    assign instr_addr = instruction[INSTR_WIDTH-3:REG_BITS];
+    assign instr_imm = instruction[FIELD_WIDTH-1:0];
 
     // Decode based on opcode
     always_comb begin
@@ -35,8 +41,8 @@ module control_unit(
                 rs2 = instr_rs2;
 
                 // other fields not used
-                addr = 4'b0000;
-                imm = 4'b0000;
+                addr = '0;
+                imm = '0;
             end
             2'b10: begin
                 // li-type instruction
@@ -44,9 +50,9 @@ module control_unit(
                 imm = instr_imm;
 
                 // other fields not used
-                rs1 = 2'b00;
-                rs2 = 2'b00;
-                addr = 4'b0000;
+                rs1 = '0;
+                rs2 = '0;
+                addr = '0;
             end
             2'b11: begin
                 // bner0-type instruction
@@ -54,19 +60,19 @@ module control_unit(
                 rs2 = instr_rs2;
 
                 // other fields not used
-                rd = 2'b00;
-                rs1 = 2'b00;
-                imm = 4'b0000;
+                rd = '0;
+                rs1 = '0;
+                imm = '0;
             end            
             default: begin
                 // TODO: Handle other opcodes
-                rd = 2'b00;
-                rs1 = 2'b00;
-                rs2 = 2'b00;
-                imm = 4'b0000;
-                addr = 4'b0000;
+                rd = '0;
+                rs1 = '0;
+                rs2 = '0;
+                imm = '0;
+                addr = '0;
             end
         endcase
     end
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,196 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "corpus.h"
+
+// Records are flushed to disk in chunks of this size
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+// ROM bytes are padded so the metadata block is 8-byte aligned
+static uint64_t metadata_offset(uint64_t rom_size) {
+    return (rom_size + 7) & ~7ull;
+}
+
+// Random ROM image for a seed (same seed, same program on every machine)
+std::vector<uint8_t> generate_program(uint64_t seed, int rom_size) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint8_t> program(rom_size);
+    for (auto& byte : program) {
+        byte = rng() & 0xFF;
+    }
+    return program;
+}
+
+// ========== CorpusWriter ==========
+
+CorpusWriter::CorpusWriter() {
+    this->file_ = nullptr;
+    std::memset(&this->header_, 0, sizeof(this->header_));
+}
+
+CorpusWriter::~CorpusWriter() {
+    close();
+}
+
+bool CorpusWriter::open(const std::string& path, uint32_t rom_size, bool with_metadata) {
+    close();
+
+    std::memset(&this->header_, 0, sizeof(this->header_));
+    std::memcpy(this->header_.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+    this->header_.version = CORPUS_VERSION;
+    this->header_.rom_size = rom_size;
+    this->header_.flags = with_metadata ? CORPUS_HAS_METADATA : 0;
+    this->header_.record_size = with_metadata ? metadata_offset(rom_size) + sizeof(CorpusMetadata) : rom_size;
+    this->header_.program_count = 0;
+
+    this->file_ = std::fopen(path.c_str(), "wb");
+    if (this->file_ == nullptr) {
+        std::cerr << "err Cannot write " << path << "\n";
+        return false;
+    }
+
+    // Header is written again with the final count by close()
+    this->buffer_.clear();
+    this->buffer_.reserve(WRITE_BUFFER_SIZE);
+    return std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1;
+}
+
+bool CorpusWriter::append(const uint8_t* rom, const CorpusMetadata* metadata) {
+    if (this->file_ == nullptr) {
+        return false;
+    }
+
+    size_t record_start = this->buffer_.size();
+    this->buffer_.resize(record_start + this->header_.record_size, 0);
+    std::memcpy(&this->buffer_[record_start], rom, this->header_.rom_size);
+    if ((this->header_.flags & CORPUS_HAS_METADATA) && metadata != nullptr) {
+        std::memcpy(&this->buffer_[record_start + metadata_offset(this->header_.rom_size)], metadata, sizeof(CorpusMetadata));
+    }
+    this->header_.program_count++;
+
+    if (this->buffer_.size() >= WRITE_BUFFER_SIZE) {
+        return flushBuffer();
+    }
+    return true;
+}
+
+bool CorpusWriter::flushBuffer() {
+    bool ok = this->buffer_.empty()
+           || std::fwrite(this->buffer_.data(), this->buffer_.size(), 1, this->file_) == 1;
+    this->buffer_.clear();
+    return ok;
+}
+
+bool CorpusWriter::close() {
+    if (this->file_ == nullptr) {
+        return true;
+    }
+
+    bool ok = flushBuffer();
+    ok = ok && std::fseek(this->file_, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1;
+    ok = (std::fclose(this->file_) == 0) && ok;
+    this->file_ = nullptr;
+    return ok;
+}
+
+// ========== CorpusReader ==========
+
+CorpusReader::CorpusReader() {
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+    this->records_ = nullptr;
+}
+
+CorpusReader::~CorpusReader() {
+    close();
+}
+
+bool CorpusReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CorpusHeader)) {
+        std::cerr << "err " << path << " is too small to be a corpus\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "err Cannot map " << path << "\n";
+        return false;
+    }
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+    // Sizes are checked by division (no overflow on a hostile program_count), and
+    // metadata must fit in every record, aligned, before metadata() hands out pointers into it
+    const CorpusHeader* header = static_cast<const CorpusHeader*>(mapping);
+    uint64_t minimum_record = header->rom_size;
+    uint64_t record_alignment = 1;
+    if (header->flags & CORPUS_HAS_METADATA) {
+        minimum_record = metadata_offset(header->rom_size) + sizeof(CorpusMetadata);
+        record_alignment = alignof(CorpusMetadata);
+    }
+    bool valid = std::memcmp(header->magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC)) == 0
+              && header->version == CORPUS_VERSION
+              && header->record_size > 0
+              && header->record_size >= minimum_record
+              && header->record_size % record_alignment == 0
+              && header->program_count <= ((uint64_t)info.st_size - sizeof(CorpusHeader)) / header->record_size;
+    if (!valid) {
+        std::cerr << "err " << path << " is not a valid corpus (version " << CORPUS_VERSION << ")\n";
+        munmap(mapping, info.st_size);
+        return false;
+    }
+
+    this->mapping_ = mapping;
+    this->mapping_size_ = info.st_size;
+    this->header_ = header;
+    this->records_ = static_cast<const uint8_t*>(mapping) + sizeof(CorpusHeader);
+    return true;
+}
+
+void CorpusReader::close() {
+    if (this->mapping_ != nullptr) {
+        munmap(this->mapping_, this->mapping_size_);
+    }
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+    this->records_ = nullptr;
+}
+
+uint64_t CorpusReader::size() {
+    return this->header_ != nullptr ? this->header_->program_count : 0;
+}
+
+uint32_t CorpusReader::romSize() {
+    return this->header_ != nullptr ? this->header_->rom_size : 0;
+}
+
+const uint8_t* CorpusReader::rom(uint64_t index) {
+    return this->records_ + index * this->header_->record_size;
+}
+
+const CorpusMetadata* CorpusReader::metadata(uint64_t index) {
+    if (!(this->header_->flags & CORPUS_HAS_METADATA)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const CorpusMetadata*>(rom(index) + metadata_offset(this->header_->rom_size));
+}
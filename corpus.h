@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Packed on-disk program corpus, read through mmap with zero copies and zero parsing.
+// Layout (little-endian):
+//   CorpusHeader (64 bytes)
+//   program_count records of record_size bytes each:
+//     ROM image (rom_size bytes), padded to 8 bytes,
+//     CorpusMetadata (24 bytes) if CORPUS_HAS_METADATA is set
+
+const char CORPUS_MAGIC[8] = { 's', 'I', 'S', 'A', 'C', 'O', 'R', 'P' };
+const uint32_t CORPUS_VERSION = 1;
+
+// CorpusHeader::flags
+const uint32_t CORPUS_HAS_METADATA = 1;
+
+// CorpusMetadata::flags
+const uint8_t CORPUS_HAS_EXPECTED = 1;
+
+struct CorpusHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t rom_size;
+    uint32_t record_size;
+    uint32_t flags;
+    uint64_t program_count;
+    uint8_t reserved[32];
+};
+static_assert(sizeof(CorpusHeader) == 64, "corpus header must stay 64 bytes");
+
+struct CorpusMetadata {
+    uint64_t seed;              // seed the program was generated from
+    uint32_t cycle_budget;      // cycles to run, 0 = harness default
+    uint8_t flags;              // CORPUS_HAS_EXPECTED
+    uint8_t expected_pc;        // sCPUMain state after cycle_budget cycles
+    uint8_t expected_regs[4];
+    uint8_t reserved[6];
+};
+static_assert(sizeof(CorpusMetadata) == 24, "corpus metadata must stay 24 bytes");
+
+// Random ROM image for a seed (same seed, same program on every machine)
+std::vector<uint8_t> generate_program(uint64_t seed, int rom_size = 16);
+
+// Appends records through a buffered writer; close() patches the program count
+class CorpusWriter {
+    public:
+        CorpusWriter();
+        ~CorpusWriter();
+
+        bool open(const std::string& path, uint32_t rom_size, bool with_metadata);
+
+        // metadata is ignored for corpora without metadata
+        bool append(const uint8_t* rom, const CorpusMetadata* metadata);
+
+        bool close();
+
+    private:
+        bool flushBuffer();
+
+        FILE* file_;
+        CorpusHeader header_;
+        std::vector<uint8_t> buffer_;
+};
+
+// Read-only view of a corpus file; pointers stay valid until close()
+class CorpusReader {
+    public:
+        CorpusReader();
+        ~CorpusReader();
+
+        // Maps the file and validates the header
+        bool open(const std::string& path);
+        void close();
+
+        uint64_t size();
+        uint32_t romSize();
+
+        // ROM image of program index (points into the mapping)
+        const uint8_t* rom(uint64_t index);
+
+        // Metadata of program index, nullptr if the corpus has none
+        const CorpusMetadata* metadata(uint64_t index);
+
+    private:
+        void* mapping_;
+        size_t mapping_size_;
+        const CorpusHeader* header_;
+        const uint8_t* records_;
+};
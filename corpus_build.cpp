@@ -0,0 +1,82 @@
+// Builds a program corpus file (see corpus.h) of random programs.
+// With metadata (default) every record carries its seed, the cycle budget and the
+// golden state after that many cycles, from sCPUMain (sized like main.sv, so the state
+// is the one campaign_test's lockstep run ends in).
+//
+// Usage:
+//   ./corpus_build <output.corpus> [--programs=N] [--seed=S] [--cycles=C] [--no-metadata]
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "options.h"
+#include "sCPU.h"
+
+int main(int argc, char** argv) {
+    std::string output_path;
+    uint64_t program_count = 1000000;
+    uint64_t base_seed = 1;
+    uint64_t cycle_budget = 256;
+    bool with_metadata = true;
+
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string arg = argv[i];
+        if (parse_option(arg, "programs", value)) {
+            program_count = value;
+        } else if (parse_option(arg, "seed", value)) {
+            base_seed = value;
+        } else if (parse_option(arg, "cycles", value)) {
+            cycle_budget = value;
+        } else if (arg == "--no-metadata") {
+            with_metadata = false;
+        } else if (unknown_option(arg)) {
+            return 1;
+        } else {
+            output_path = arg;
+        }
+    }
+    if (output_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <output.corpus> [--programs=N] [--seed=S] [--cycles=C] [--no-metadata]\n";
+        return 1;
+    }
+
+    CorpusWriter writer;
+    if (!writer.open(output_path, 16, with_metadata)) {
+        return 1;
+    }
+
+    for (uint64_t i = 0; i < program_count; i++) {
+        uint64_t seed = base_seed + i;
+        std::vector<uint8_t> program = generate_program(seed, 16);
+
+        CorpusMetadata metadata = {};
+        if (with_metadata) {
+            sCPUMain golden_cpu;
+            golden_cpu.loadInstructions(program);
+            sCPUMain::RunResult result = golden_cpu.run(cycle_budget);
+
+            metadata.seed = seed;
+            metadata.cycle_budget = cycle_budget;
+            metadata.flags = CORPUS_HAS_EXPECTED;
+            metadata.expected_pc = result.pc;
+            for (int r = 0; r < 4; r++) {
+                metadata.expected_regs[r] = result.regs[r];
+            }
+        }
+        if (!writer.append(program.data(), &metadata)) {
+            std::cerr << "err Write failed at program " << i << "\n";
+            return 1;
+        }
+    }
+    if (!writer.close()) {
+        std::cerr << "err Cannot finish " << output_path << "\n";
+        return 1;
+    }
+
+    std::cout << "ok Wrote " << program_count << " programs (seeds " << base_seed << ".." << base_seed + program_count - 1
+              << (with_metadata ? ", with metadata" : "") << ") to " << output_path << "\n";
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "corpus.h"
+
+int main() {
+    std::cout << "Testing Program Corpus (write, mmap read back)\n";
+    std::cout << "==============================================\n\n";
+
+    const char* path = "corpus_test.corpus";
+    const int program_count = 5000;
+
+    // Test 1: write programs with metadata
+    std::cout << "Test 1: Write " << program_count << " programs with metadata\n";
+    CorpusWriter writer;
+    if (!writer.open(path, 16, true)) {
+        std::cerr << "  ✗ FAIL: cannot open writer\n";
+        return 1;
+    }
+    for (int i = 0; i < program_count; i++) {
+        std::vector<uint8_t> program = generate_program(i, 16);
+        CorpusMetadata metadata = {};
+        metadata.seed = i;
+        metadata.cycle_budget = 100 + i;
+        metadata.expected_regs[2] = i & 0xFF;
+        writer.append(program.data(), &metadata);
+    }
+    if (!writer.close()) {
+        std::cerr << "  ✗ FAIL: close failed\n";
+        return 1;
+    }
+    std::cout << "  ✓ Written\n\n";
+
+    // Test 2: read back through the mapping
+    std::cout << "Test 2: Read back through mmap\n";
+    CorpusReader reader;
+    if (!reader.open(path) || reader.size() != program_count || reader.romSize() != 16) {
+        std::cerr << "  ✗ FAIL: header mismatch, size " << reader.size() << "\n";
+        return 1;
+    }
+    for (int i = 0; i < program_count; i++) {
+        std::vector<uint8_t> expected = generate_program(i, 16);
+        const uint8_t* rom = reader.rom(i);
+        const CorpusMetadata* metadata = reader.metadata(i);
+        if (!std::equal(expected.begin(), expected.end(), rom)) {
+            std::cerr << "  ✗ FAIL: ROM of program " << i << " differs\n";
+            return 1;
+        }
+        if (metadata == nullptr || metadata->seed != (uint64_t)i || metadata->cycle_budget != (uint32_t)(100 + i)
+            || metadata->expected_regs[2] != (i & 0xFF)) {
+            std::cerr << "  ✗ FAIL: metadata of program " << i << " differs\n";
+            return 1;
+        }
+    }
+    reader.close();
+    std::cout << "  ✓ All ROM images and metadata match\n\n";
+
+    // Test 3: corpus without metadata
+    std::cout << "Test 3: Corpus without metadata\n";
+    writer.open(path, 16, false);
+    std::vector<uint8_t> program = generate_program(7, 16);
+    writer.append(program.data(), nullptr);
+    writer.close();
+    if (!reader.open(path) || reader.size() != 1 || reader.metadata(0) != nullptr
+        || !std::equal(program.begin(), program.end(), reader.rom(0))) {
+        std::cerr << "  ✗ FAIL: metadata-free corpus read back wrong\n";
+        return 1;
+    }
+    reader.close();
+    std::cout << "  ✓ ROM only records\n\n";
+
+    // Test 4: reject files that are not corpora
+    std::cout << "Test 4: Reject invalid files\n";
+    FILE* file = std::fopen(path, "wb");
+    std::fputs("10001010    # 0: li r0, 10 -- text, not a corpus ...................................\n", file);
+    std::fclose(file);
+    if (reader.open(path)) {
+        std::cerr << "  ✗ FAIL: text file accepted as corpus\n";
+        return 1;
+    }
+    std::cout << "  ✓ Rejected\n\n";
+
+    // Test 5: reject corrupted headers of a real corpus
+    std::cout << "Test 5: Reject inconsistent headers\n";
+    writer.open(path, 16, true);
+    for (int i = 0; i < 2; i++) {
+        CorpusMetadata metadata = {};
+        writer.append(generate_program(i, 16).data(), &metadata);
+    }
+    writer.close();
+    file = std::fopen(path, "rb");
+    std::vector<uint8_t> bytes(4096);
+    bytes.resize(std::fread(bytes.data(), 1, bytes.size(), file));
+    std::fclose(file);
+    CorpusHeader original;
+    std::memcpy(&original, bytes.data(), sizeof(original));
+
+    struct Corruption { const char* name; uint32_t record_size; uint64_t program_count; };
+    const Corruption corruptions[] = {
+        { "record_size 0", 0, 2 },
+        { "metadata outside the record", 16, 2 },
+        { "misaligned metadata", original.record_size + 4, 1 },
+        { "one record past the end", original.record_size, 3 },
+        { "program_count * record_size overflows", original.record_size, UINT64_MAX / original.record_size + 1 }
+    };
+    for (const Corruption& corruption : corruptions) {
+        CorpusHeader header = original;
+        header.record_size = corruption.record_size;
+        header.program_count = corruption.program_count;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        file = std::fopen(path, "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+        if (reader.open(path)) {
+            std::cerr << "  ✗ FAIL: accepted a header with " << corruption.name << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Record size 0, metadata past the record, misaligned metadata, too many records, size overflow\n\n";
+
+    std::remove(path);
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
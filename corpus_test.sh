@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 corpus_test.cpp corpus.cpp -o corpus_test
+./corpus_test
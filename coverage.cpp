@@ -0,0 +1,116 @@
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "coverage.h"
+
+const char COVERAGE_FILE_HEADER[] = "sISA-coverage 1";
+
+std::string coverage_point_name(int point) {
+    static const char* const OPCODES[4] = { "add", "nop", "load", "bner0" };
+    std::ostringstream name;
+    if (point < COVERAGE_ADD_OPERANDS) {
+        int index = point - COVERAGE_OPCODE_RD;
+        name << "opcode_rd." << OPCODES[index / COVERAGE_REGISTERS] << ".r" << index % COVERAGE_REGISTERS;
+    } else if (point < COVERAGE_BNER0) {
+        int index = point - COVERAGE_ADD_OPERANDS;
+        name << "add_operands.r" << index / COVERAGE_REGISTERS << ".r" << index % COVERAGE_REGISTERS;
+    } else if (point < COVERAGE_ADD_CARRY) {
+        int index = point - COVERAGE_BNER0;
+        name << (index % 2 == 0 ? "bner0_taken.r" : "bner0_not_taken.r") << index / 2;
+    } else if (point == COVERAGE_ADD_CARRY) {
+        name << "add_carry";
+    } else if (point == COVERAGE_ADD_OVERFLOW) {
+        name << "add_overflow";
+    } else if (point == COVERAGE_PC_WRAP) {
+        name << "pc_wrap";
+    } else if (point == COVERAGE_BRANCH_TO_SELF) {
+        name << "branch_to_self_taken";
+    } else {
+        name << "branch_to_self_not_taken";
+    }
+    return name.str();
+}
+
+// ========== CoverageDatabase ==========
+
+void CoverageDatabase::merge(const CoverageShard& shard) {
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        if (shard.counts[i] != 0) {
+            this->counts_[i].fetch_add(shard.counts[i], std::memory_order_relaxed);
+        }
+    }
+    this->bitmap_.fetch_or(shard.bitmap, std::memory_order_relaxed);
+}
+
+int CoverageDatabase::covered() const {
+    return __builtin_popcountll(bitmap() & ~COVERAGE_UNREACHABLE);
+}
+
+void CoverageDatabase::clear() {
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        this->counts_[i].store(0, std::memory_order_relaxed);
+    }
+    this->bitmap_.store(0, std::memory_order_relaxed);
+}
+
+bool CoverageDatabase::read(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+    std::string header;
+    if (!std::getline(in, header) || header != COVERAGE_FILE_HEADER) {
+        std::cerr << "err " << path << " is not a coverage database\n";
+        return false;
+    }
+
+    std::map<std::string, int> points;
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        points[coverage_point_name(i)] = i;
+    }
+    CoverageShard shard;
+    std::string name;
+    uint64_t count;
+    while (in >> name >> count) {
+        std::map<std::string, int>::const_iterator point = points.find(name);
+        if (point == points.end()) {
+            std::cerr << "err " << path << ": unknown coverage point " << name << "\n";
+            return false;
+        }
+        shard.counts[point->second] += count;
+        if (count != 0) {
+            shard.bitmap |= 1ull << point->second;
+        }
+    }
+    if (!in.eof()) {
+        std::cerr << "err " << path << ": malformed line after " << name << "\n";
+        return false;
+    }
+    merge(shard);
+    return true;
+}
+
+bool CoverageDatabase::write(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "err Cannot write " << path << "\n";
+        return false;
+    }
+    out << COVERAGE_FILE_HEADER << "\n";
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        out << coverage_point_name(i) << " " << count(i) << "\n";
+    }
+    return (bool)out;
+}
+
+void CoverageDatabase::report(std::ostream& out) const {
+    out << "Coverage: " << covered() << "/" << COVERAGE_REACHABLE_POINTS << " points\n";
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        if (count(i) == 0 && !(COVERAGE_UNREACHABLE & (1ull << i))) {
+            out << "  not covered: " << coverage_point_name(i) << "\n";
+        }
+    }
+}
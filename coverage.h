@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include "sCPU.h"
+
+// Functional coverage of the sISA. Points (45, one bit each in a 64-bit bitmap):
+//   opcode_rd.<op>.r<d>        every opcode x rd field (bits 5:4, also for NOP / BNER0)
+//   add_operands.r<s1>.r<s2>   every rs1 / rs2 pairing of ADD
+//   bner0_taken.r<s2>          BNER0 outcome per source register (bner0_taken.r0 cannot be
+//   bner0_not_taken.r<s2>      hit: r0 is never unequal to, or greater than, itself)
+//   add_carry                  ADD carry-out (unsigned wraparound)
+//   add_overflow               ADD signed overflow
+//   pc_wrap                    sequential PC wrap (15 -> 0 on main.sv, 255 -> 0 on sCPU)
+//   branch_to_self_taken       BNER0 whose target is its own address (halt)
+//   branch_to_self_not_taken
+//
+// Every worker samples into its own CoverageShard (plain counters, no sharing); shards are
+// merged into a CoverageDatabase with atomic adds / ors, so workers never lock. Databases
+// are text files of "name count" lines; reading a file adds its counts, so merging runs
+// is reading their files into one database and writing it out.
+
+// Register count the per-register points are laid out for (main.sv's register file);
+// GoldenAdapter::cover only accepts models with exactly this many registers
+const int COVERAGE_REGISTERS = 4;
+
+const int COVERAGE_OPCODE_RD = 0;
+const int COVERAGE_ADD_OPERANDS = COVERAGE_OPCODE_RD + 4 * COVERAGE_REGISTERS;
+const int COVERAGE_BNER0 = COVERAGE_ADD_OPERANDS + COVERAGE_REGISTERS * COVERAGE_REGISTERS;
+const int COVERAGE_ADD_CARRY = COVERAGE_BNER0 + 2 * COVERAGE_REGISTERS;
+const int COVERAGE_ADD_OVERFLOW = COVERAGE_ADD_CARRY + 1;
+const int COVERAGE_PC_WRAP = COVERAGE_ADD_OVERFLOW + 1;
+const int COVERAGE_BRANCH_TO_SELF = COVERAGE_PC_WRAP + 1;
+const int COVERAGE_POINTS = COVERAGE_BRANCH_TO_SELF + 2;
+
+// Points no program can hit, left out of the covered / reachable totals
+const uint64_t COVERAGE_UNREACHABLE = 1ull << COVERAGE_BNER0;
+const int COVERAGE_REACHABLE_POINTS = COVERAGE_POINTS - 1;
+
+static_assert(COVERAGE_POINTS <= 64, "coverage bitmap is one 64-bit word");
+
+// One retired instruction, as observed by a model adapter (lockstep.h, lockstep_verilated.h).
+// Adapters hand it to any sink with sample(const CoverageEvent&): CoverageShard, or the
+// fuzzer's FuzzSampler (fuzz.h)
+struct CoverageEvent {
+    uint8_t pc;
+    uint8_t next_pc;
+    uint8_t kind;           // sCPU::OpKind
+    uint8_t rd;             // bits 5:4
+    uint8_t rs1;
+    uint8_t rs2;
+    bool taken;             // BNER0 branched
+    bool carry;             // ADD carry-out
+    bool overflow;          // ADD signed overflow
+    bool branch_to_self;    // BNER0 target == its PC
+    bool pc_wrapped;        // PC went from the last address to 0 without a branch
+};
+
+// Name of point, e.g. "add_operands.r1.r3"
+std::string coverage_point_name(int point);
+
+// Per-worker counters; events must have register fields below COVERAGE_REGISTERS
+struct alignas(64) CoverageShard {
+    uint64_t counts[COVERAGE_POINTS];
+    uint64_t bitmap;
+
+    CoverageShard() { clear(); }
+
+    void hit(int point) {
+        this->counts[point]++;
+        this->bitmap |= 1ull << point;
+    }
+
+    void sample(const CoverageEvent& event) {
+        hit(COVERAGE_OPCODE_RD + event.kind * COVERAGE_REGISTERS + event.rd);
+        if (event.kind == sCPU::OP_ADD) {
+            hit(COVERAGE_ADD_OPERANDS + event.rs1 * COVERAGE_REGISTERS + event.rs2);
+            if (event.carry) {
+                hit(COVERAGE_ADD_CARRY);
+            }
+            if (event.overflow) {
+                hit(COVERAGE_ADD_OVERFLOW);
+            }
+        } else if (event.kind == sCPU::OP_BNER0) {
+            hit(COVERAGE_BNER0 + event.rs2 * 2 + (event.taken ? 0 : 1));
+            if (event.branch_to_self) {
+                hit(COVERAGE_BRANCH_TO_SELF + (event.taken ? 0 : 1));
+            }
+        }
+        if (event.pc_wrapped) {
+            hit(COVERAGE_PC_WRAP);
+        }
+    }
+
+    void clear() {
+        for (int i = 0; i < COVERAGE_POINTS; i++) {
+            this->counts[i] = 0;
+        }
+        this->bitmap = 0;
+    }
+};
+
+// Coverage merged from all workers (and files)
+class CoverageDatabase {
+    public:
+        CoverageDatabase() { clear(); }
+
+        // Lock-free; any number of workers may merge at once
+        void merge(const CoverageShard& shard);
+
+        // Publish only the bitmap (cheap enough after every program); returns the points
+        // that were new to the database
+        uint64_t mergeBitmap(uint64_t bitmap) {
+            return bitmap & ~this->bitmap_.fetch_or(bitmap, std::memory_order_relaxed);
+        }
+
+        uint64_t bitmap() const { return this->bitmap_.load(std::memory_order_relaxed); }
+        uint64_t count(int point) const { return this->counts_[point].load(std::memory_order_relaxed); }
+        int covered() const;    // reachable points hit
+
+        void clear();
+
+        // Adds the counts of a database file; false if it cannot be read or parsed
+        bool read(const std::string& path);
+        bool write(const std::string& path) const;
+
+        // "covered/reachable" line and the reachable points never hit
+        void report(std::ostream& out) const;
+
+    private:
+        std::atomic<uint64_t> counts_[COVERAGE_POINTS];
+        std::atomic<uint64_t> bitmap_;
+};
+
+// Derived flags of an ADD of a and b (8-bit data path)
+inline void coverage_add_flags(uint8_t a, uint8_t b, CoverageEvent& event) {
+    uint8_t sum = a + b;
+    event.carry = (unsigned)a + b > 0xFF;
+    event.overflow = ((a ^ sum) & (b ^ sum) & 0x80) != 0;
+}
@@ -0,0 +1,26 @@
+// Merges coverage databases (coverage.h) of several runs:
+//   ./coverage_merge merged.cov run1.cov run2.cov ...
+// The output may also be one of the inputs, to accumulate into it.
+
+#include <iostream>
+#include "coverage.h"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <output.cov> <input.cov>...\n";
+        return 2;
+    }
+
+    CoverageDatabase database;
+    for (int i = 2; i < argc; i++) {
+        if (!database.read(argv[i])) {
+            return 1;
+        }
+    }
+    if (!database.write(argv[1])) {
+        return 1;
+    }
+    database.report(std::cout);
+    std::cout << "ok " << argc - 2 << " databases merged into " << argv[1] << "\n";
+    return 0;
+}
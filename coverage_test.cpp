@@ -0,0 +1,195 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "coverage.h"
+#include "lockstep.h"
+#include "sCPU.h"
+
+// Example program of instruction_memory.sv (r2 = 1 + ... + 10)
+const uint8_t SUM_LOOP[] = { 0x8A, 0x90, 0xA0, 0xB1, 0x17, 0x29, 0xD1, 0xDF };
+
+// Cover program from reset until it halts (the halting instruction included) or max_cycles
+void cover_program(const uint8_t* program, size_t size, int max_cycles, CoverageShard& shard) {
+    sCPUMain cpu;
+    cpu.loadInstructions(program, size);
+    GoldenAdapter<sCPUMain> golden(cpu);
+    for (int cycle = 0; cycle < max_cycles; cycle++) {
+        bool halted = golden.halted();
+        golden.cover(shard);
+        if (halted) {
+            break;
+        }
+    }
+}
+
+int point(const std::string& name) {
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        if (coverage_point_name(i) == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+std::vector<uint8_t> random_program(std::mt19937& rng) {
+    std::vector<uint8_t> program(16);
+    for (uint8_t& instruction : program) {
+        instruction = rng() & 0xFF;
+    }
+    return program;
+}
+
+int main() {
+    std::cout << "Testing functional coverage\n";
+    std::cout << "===========================\n\n";
+
+    // Test 1: point names
+    std::cout << "Test 1: " << COVERAGE_POINTS << " distinct point names\n";
+    std::set<std::string> names;
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        names.insert(coverage_point_name(i));
+    }
+    if ((int)names.size() != COVERAGE_POINTS || point("opcode_rd.bner0.r3") != COVERAGE_OPCODE_RD + 15
+        || point("add_operands.r1.r3") != COVERAGE_ADD_OPERANDS + 7 || point("bner0_not_taken.r1") != COVERAGE_BNER0 + 3
+        || point("branch_to_self_not_taken") != COVERAGE_POINTS - 1) {
+        std::cerr << "  ✗ FAIL: names not distinct or not in point order\n";
+        return 1;
+    }
+    std::cout << "  ✓ e.g. " << coverage_point_name(COVERAGE_ADD_OPERANDS + 7) << "\n\n";
+
+    // Test 2: exact counts of the sum loop
+    std::cout << "Test 2: Sum loop counts\n";
+    CoverageShard sum;
+    cover_program(SUM_LOOP, sizeof(SUM_LOOP), 1000, sum);
+    struct Expected { const char* name; uint64_t count; };
+    const Expected expected[] = {
+        { "opcode_rd.load.r0", 1 }, { "opcode_rd.load.r3", 1 },
+        { "opcode_rd.add.r1", 10 }, { "opcode_rd.add.r2", 10 },
+        { "add_operands.r1.r3", 10 }, { "add_operands.r2.r1", 10 },
+        { "opcode_rd.bner0.r1", 11 },   // bner0 r1, 4 and bner0 r3, 7 both have 01 in bits 5:4
+        { "bner0_taken.r1", 9 }, { "bner0_not_taken.r1", 1 }, { "bner0_taken.r3", 1 },
+        { "branch_to_self_taken", 1 }, { "add_carry", 0 }, { "add_overflow", 0 }, { "pc_wrap", 0 }
+    };
+    for (const Expected& e : expected) {
+        if (sum.counts[point(e.name)] != e.count) {
+            std::cerr << "  ✗ FAIL: " << e.name << " = " << sum.counts[point(e.name)] << ", expected " << e.count << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ " << __builtin_popcountll(sum.bitmap) << " points, counts as expected\n\n";
+
+    // Test 3: wraparound points
+    std::cout << "Test 3: ADD carry / overflow and PC wrap 15 -> 0\n";
+    const uint8_t DOUBLING[16] = {
+        0x9F,                               // li r1, 15
+        0x15, 0x15, 0x15, 0x15, 0x15,       // add r1, r1, r1: 30, 60, 120, 240 (overflow), 224 (carry)
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80  // li r0, 0 up to slot 15
+    };
+    CoverageShard wrap;
+    cover_program(DOUBLING, sizeof(DOUBLING), 17, wrap);
+    if (wrap.counts[COVERAGE_ADD_OVERFLOW] != 1 || wrap.counts[COVERAGE_ADD_CARRY] != 1
+        || wrap.counts[COVERAGE_PC_WRAP] != 1) {
+        std::cerr << "  ✗ FAIL: overflow " << wrap.counts[COVERAGE_ADD_OVERFLOW] << ", carry "
+                  << wrap.counts[COVERAGE_ADD_CARRY] << ", wrap " << wrap.counts[COVERAGE_PC_WRAP] << "\n";
+        return 1;
+    }
+    std::cout << "  ✓ overflow 120 + 120, carry 240 + 240, one wrap\n\n";
+
+    // Test 4: per-thread shards merged lock-free equal one sequential shard
+    const int THREADS = 8;
+    const int PROGRAMS = 2000;
+    std::cout << "Test 4: " << THREADS << " threads x " << PROGRAMS << " random programs merged lock-free\n";
+    CoverageDatabase database;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t, &database]() {
+            std::mt19937 rng(100 + t);
+            CoverageShard shard;
+            for (int p = 0; p < PROGRAMS; p++) {
+                std::vector<uint8_t> program = random_program(rng);
+                cover_program(program.data(), program.size(), 64, shard);
+                database.mergeBitmap(shard.bitmap);
+            }
+            database.merge(shard);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CoverageShard sequential;
+    for (int t = 0; t < THREADS; t++) {
+        std::mt19937 rng(100 + t);
+        for (int p = 0; p < PROGRAMS; p++) {
+            std::vector<uint8_t> program = random_program(rng);
+            cover_program(program.data(), program.size(), 64, sequential);
+        }
+    }
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        if (database.count(i) != sequential.counts[i]) {
+            std::cerr << "  ✗ FAIL: " << coverage_point_name(i) << " merged " << database.count(i)
+                      << ", sequential " << sequential.counts[i] << "\n";
+            return 1;
+        }
+    }
+    if (database.bitmap() != sequential.bitmap || database.covered() != COVERAGE_REACHABLE_POINTS
+        || (database.bitmap() & COVERAGE_UNREACHABLE) != 0) {
+        std::cerr << "  ✗ FAIL: " << database.covered() << "/" << COVERAGE_REACHABLE_POINTS << " covered\n";
+        return 1;
+    }
+    std::cout << "  ✓ identical counts, " << database.covered() << "/" << COVERAGE_REACHABLE_POINTS << " points\n\n";
+
+    // Test 5: database files merge by adding counts
+    std::cout << "Test 5: Database file round trip and merge\n";
+    const char* path = "coverage_test.cov";
+    CoverageDatabase sum_database;
+    sum_database.merge(sum);
+    if (!sum_database.write(path)) {
+        std::cerr << "  ✗ FAIL: cannot write " << path << "\n";
+        return 1;
+    }
+    CoverageDatabase merged;
+    if (!merged.read(path) || !merged.read(path)) {
+        std::cerr << "  ✗ FAIL: cannot read " << path << " back\n";
+        return 1;
+    }
+    for (int i = 0; i < COVERAGE_POINTS; i++) {
+        if (merged.count(i) != 2 * sum.counts[i]) {
+            std::cerr << "  ✗ FAIL: " << coverage_point_name(i) << " = " << merged.count(i) << " after merging twice\n";
+            return 1;
+        }
+    }
+    if (merged.bitmap() != sum.bitmap) {
+        std::cerr << "  ✗ FAIL: bitmap differs after reading\n";
+        return 1;
+    }
+    std::cout << "  ✓ counts doubled, same points\n\n";
+
+    // Test 6: malformed files are rejected
+    std::cout << "Test 6: Malformed database files\n";
+    {
+        std::ofstream bad(path);
+        bad << "sISA-coverage 1\nadd_carry 3\nno_such_point 1\n";
+    }
+    CoverageDatabase rejected;
+    bool unknown_rejected = !rejected.read(path);
+    {
+        std::ofstream bad(path);
+        bad << "sISA-coverage 1\nadd_carry three\n";
+    }
+    bool malformed_rejected = !rejected.read(path);
+    std::remove(path);
+    if (!unknown_rejected || !malformed_rejected || rejected.covered() != 0) {
+        std::cerr << "  ✗ FAIL: malformed file accepted\n";
+        return 1;
+    }
+    std::cout << "  ✓ unknown point and bad count rejected, nothing merged\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,4 @@
+g++ -O2 -std=c++17 -pthread coverage_test.cpp coverage.cpp sCPU.cpp -o coverage_test
+./coverage_test
+
+g++ -O2 -std=c++17 coverage_merge.cpp coverage.cpp sCPU.cpp -o coverage_merge
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "fuzz.h"
+
+// ========== FuzzMap ==========
+
+// Hit count -> bucket bit (1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+)
+static uint8_t fuzz_bucket(uint8_t count) {
+    if (count <= 3) {
+        return count == 0 ? 0 : 1 << (count - 1);
+    }
+    if (count < 8) {
+        return 8;
+    }
+    if (count < 16) {
+        return 16;
+    }
+    if (count < 32) {
+        return 32;
+    }
+    return count < 128 ? 64 : 128;
+}
+
+int FuzzMap::update() {
+    int fresh = 0;
+    for (uint32_t i = 0; i < FUZZ_MAP_SIZE; i++) {
+        if (this->trace_[i] == 0) {
+            continue;
+        }
+        uint8_t bucket = fuzz_bucket(this->trace_[i]);
+        if (this->virgin_[i] & bucket) {
+            this->virgin_[i] &= ~bucket;
+            fresh++;
+        }
+    }
+    return fresh;
+}
+
+int FuzzMap::covered() const {
+    int count = 0;
+    for (uint32_t i = 0; i < FUZZ_MAP_SIZE; i++) {
+        count += __builtin_popcount((uint8_t)~this->virgin_[i]);
+    }
+    return count;
+}
+
+// ========== Fuzzer ==========
+
+Fuzzer::Fuzzer(uint64_t seed) : rng_(seed) {
+    this->stats_.executions = 0;
+    this->stats_.kept = 0;
+    this->stats_.mutants = 0;
+}
+
+void Fuzzer::addSeed(const std::vector<uint8_t>& program) {
+    std::vector<uint8_t> rom(program);
+    rom.resize(FUZZ_ROM_SIZE, 0);
+    this->corpus_.push_back(rom);
+}
+
+// Biased towards the instructions random bytes rarely give: branches near their own
+// slot and small immediates
+uint8_t Fuzzer::randomInstruction() {
+    uint8_t byte = this->rng_() & 0xFF;
+    switch (this->rng_() % 4) {
+        case 0: return 0xC0 | (byte & 0x3F);                        // BNER0, any target
+        case 1: return 0x80 | (byte & 0x30) | (this->rng_() % 3);   // LI rd, 0..2
+        default: return byte;
+    }
+}
+
+void Fuzzer::mutate(std::vector<uint8_t>& program) {
+    int count = 1 << (this->rng_() % 5);
+    for (int m = 0; m < count; m++) {
+        int slot = this->rng_() % FUZZ_ROM_SIZE;
+        int other = this->rng_() % FUZZ_ROM_SIZE;
+        switch (this->rng_() % 7) {
+            case 0:     // bit flip
+                program[slot] ^= 1 << (this->rng_() % 8);
+                break;
+            case 1:     // new instruction
+                program[slot] = randomInstruction();
+                break;
+            case 2:     // swap two instructions
+                std::swap(program[slot], program[other]);
+                break;
+            case 3:     // duplicate an instruction
+                program[other] = program[slot];
+                break;
+            case 4:     // branch to a slot at or before itself (loops, branch-to-self)
+                program[slot] = 0xC0 | ((this->rng_() % (slot + 1)) << 2) | (this->rng_() % 4);
+                break;
+            case 5:     // register fields only (bits 1:0, or 3:2 of ADD)
+                program[slot] ^= (1 + this->rng_() % 3) << ((program[slot] >> 6) == 0 ? 2 * (this->rng_() % 2) : 0);
+                break;
+            default: {  // splice the same slots of another corpus entry
+                if (this->corpus_.empty()) {
+                    break;
+                }
+                const std::vector<uint8_t>& donor = this->corpus_[this->rng_() % this->corpus_.size()];
+                int begin = std::min(slot, other);
+                int end = std::max(slot, other) + 1;
+                std::copy(donor.begin() + begin, donor.begin() + end, program.begin() + begin);
+                break;
+            }
+        }
+    }
+}
+
+// A mutant of a corpus entry; one in four (and all while the corpus is empty) is a fresh
+// random program, which early on still finds more than mutating the few entries
+std::vector<uint8_t> Fuzzer::next() {
+    std::vector<uint8_t> program(FUZZ_ROM_SIZE);
+    if (this->corpus_.empty() || this->rng_() % 4 == 0) {
+        for (uint8_t& instruction : program) {
+            instruction = this->rng_() & 0xFF;
+        }
+        return program;
+    }
+    // Newer entries found something the older ones did not: favour the recent half
+    size_t size = this->corpus_.size();
+    size_t index = this->rng_() % 2 ? this->rng_() % size : size / 2 + this->rng_() % (size - size / 2);
+    program = this->corpus_[index];
+    mutate(program);
+    this->stats_.mutants++;
+    return program;
+}
+
+bool Fuzzer::report(const std::vector<uint8_t>& program, FuzzMap& map) {
+    this->stats_.executions++;
+    if (map.update() == 0) {
+        return false;
+    }
+    this->corpus_.push_back(program);
+    this->stats_.kept++;
+    return true;
+}
+
+bool Fuzzer::load(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return true;    // no corpus yet
+    }
+    std::fclose(file);
+
+    CorpusReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < reader.size(); i++) {
+        const uint8_t* rom = reader.rom(i);
+        addSeed(std::vector<uint8_t>(rom, rom + reader.romSize()));
+    }
+    return true;
+}
+
+// Written to a temporary file first, so an interrupted save keeps the previous corpus
+bool Fuzzer::save(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    CorpusWriter writer;
+    if (!writer.open(temporary, FUZZ_ROM_SIZE, false)) {
+        return false;
+    }
+    for (const std::vector<uint8_t>& program : this->corpus_) {
+        if (!writer.append(program.data(), nullptr)) {
+            return false;
+        }
+    }
+    if (!writer.close() || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "err Cannot write " << path << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "coverage.h"
+
+// Coverage-guided program fuzzer, in the style of AFL: a corpus of 16-byte ROM images is
+// mutated (bit flips, instruction swaps, interesting instructions, splices from other
+// corpus entries), every mutant runs in the caller's harness, and mutants whose feedback
+// hits something new join the corpus. Everything stays in one process; the corpus
+// persists as a corpus file (corpus.h), so later sessions and campaigns can reuse it.
+//
+// Feedback is a FuzzMap of hit counters filled by one FuzzSampler per model (coverage
+// sink, see CoverageEvent): PC transitions, opcode x register fields per kind, BNER0
+// outcome per site, and the carry / overflow / wrap / branch-to-self events. As in AFL,
+// counts are bucketed (1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+), so a loop running more
+// iterations than ever before also counts as new.
+
+const int FUZZ_ROM_SIZE = 16;
+const uint32_t FUZZ_MAP_SIZE = 2048;
+const uint32_t FUZZ_SIDE_SIZE = 1024;   // map half per model (designed, golden)
+
+class FuzzMap {
+    public:
+        FuzzMap() {
+            clear();
+            std::memset(this->virgin_, 0xFF, sizeof(this->virgin_));
+        }
+
+        // Before each execution
+        void clear() {
+            std::memset(this->trace_, 0, sizeof(this->trace_));
+        }
+
+        void hit(uint32_t index) {
+            uint8_t& count = this->trace_[index & (FUZZ_MAP_SIZE - 1)];
+            if (count != 0xFF) {
+                count++;
+            }
+        }
+
+        // Buckets the counts of the last execution and clears their bits in the virgin
+        // map; returns the number of (index, bucket) pairs never seen before
+        int update();
+
+        // (index, bucket) pairs seen by any execution so far
+        int covered() const;
+
+        const uint8_t* trace() const { return this->trace_; }
+
+    private:
+        uint8_t trace_[FUZZ_MAP_SIZE];
+        uint8_t virgin_[FUZZ_MAP_SIZE];     // bucket bits not seen yet, per index
+};
+
+// Coverage sink writing one model's events into its half of a FuzzMap
+class FuzzSampler {
+    public:
+        FuzzSampler(FuzzMap& map, int side) : map_(map), base_(side * FUZZ_SIDE_SIZE) {}
+
+        void sample(const CoverageEvent& event) {
+            // PC transitions (4-bit PC of main.sv)
+            this->map_.hit(this->base_ + (((event.pc & 0xF) << 4) | (event.next_pc & 0xF)));
+            // Opcode x rd field x rs1 / rs2 of the instruction
+            uint32_t rs = event.kind == sCPU::OP_ADD ? event.rs1 * 4 + event.rs2 : event.rs2;
+            this->map_.hit(this->base_ + 256 + event.kind * 64 + event.rd * 16 + rs);
+            if (event.kind == sCPU::OP_BNER0) {
+                this->map_.hit(this->base_ + 512 + (event.pc & 0xF) * 2 + (event.taken ? 1 : 0));
+            }
+            if (event.carry) {
+                this->map_.hit(this->base_ + 544);
+            }
+            if (event.overflow) {
+                this->map_.hit(this->base_ + 545);
+            }
+            if (event.pc_wrapped) {
+                this->map_.hit(this->base_ + 546);
+            }
+            if (event.branch_to_self) {
+                this->map_.hit(this->base_ + 547 + (event.taken ? 1 : 0));
+            }
+        }
+
+    private:
+        FuzzMap& map_;
+        uint32_t base_;
+};
+
+struct FuzzStats {
+    uint64_t executions;
+    uint64_t kept;          // mutants added to the corpus
+    uint64_t mutants;       // programs from next() that mutate a corpus entry (the rest are fresh)
+};
+
+class Fuzzer {
+    public:
+        explicit Fuzzer(uint64_t seed);
+
+        // Corpus entries (ROM images, padded / cut to FUZZ_ROM_SIZE); seeds are kept even
+        // without new coverage
+        void addSeed(const std::vector<uint8_t>& program);
+        const std::vector<std::vector<uint8_t> >& corpus() const { return this->corpus_; }
+
+        // Next program to run: a mutant of a corpus entry, or a fresh random program
+        std::vector<uint8_t> next();
+
+        // Feedback of program's execution (map filled since its clear()); keeps it if the
+        // feedback was new. Returns true if kept.
+        bool report(const std::vector<uint8_t>& program, FuzzMap& map);
+
+        // Stacks 1..16 random mutations onto program
+        void mutate(std::vector<uint8_t>& program);
+
+        // Persistent corpus (corpus.h format, no metadata). load adds the file's programs
+        // as seeds; a missing file is an empty corpus.
+        bool load(const std::string& path);
+        bool save(const std::string& path) const;
+
+        const FuzzStats& stats() const { return this->stats_; }
+
+    private:
+        uint8_t randomInstruction();
+
+        std::mt19937_64 rng_;
+        std::vector<std::vector<uint8_t> > corpus_;
+        FuzzStats stats_;
+};
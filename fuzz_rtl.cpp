@@ -0,0 +1,175 @@
+// Coverage-guided fuzzing of the designed CPU (Vmain) against the golden CPU (sCPUMain).
+// Mutated 16-byte ROM images (fuzz.h) run in lockstep on one in-process Vmain, reloaded
+// through its public ROM array and reset for every program. Both models feed a FuzzMap;
+// programs with new feedback join the corpus, divergent programs go to a failure corpus.
+//
+// Options:
+//   --executions=N   programs to run (default 1000000)
+//   --seed=S         mutation RNG seed (default 1)
+//   --cycles=C       per-program cycle cap (default 256)
+//   --corpus=FILE    persistent corpus, loaded at start and saved periodically and at the
+//                    end (default fuzz.corpus, corpus.h format)
+//   --failures=FILE  divergent programs (default fuzz_failures.corpus), e.g. for
+//                    campaign_test --corpus=FILE
+//   --save-every=N   save the corpus every N executions (default 100000)
+//   --stop-on-failure  stop at the first divergent program
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <verilated.h>
+#include "Vmain.h"
+#include "campaign.h"
+#include "corpus.h"
+#include "fuzz.h"
+#include "lockstep_verilated.h"
+#include "options.h"
+#include "sCPU.h"
+
+typedef VerilatedAdapter<Vmain> DesignedAdapter;
+
+// One program in lockstep, both models sampling into map; false and reason on a mismatch
+bool fuzz_one(Vmain& designed_cpu, const std::vector<uint8_t>& program, int max_cycles, FuzzMap& map,
+              std::string& reason) {
+    load_rom(&designed_cpu, program.data(), program.size());
+    DesignedAdapter designed(designed_cpu);
+    designed.reset();
+
+    sCPUMain golden_cpu;
+    golden_cpu.loadInstructions(program);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+
+    FuzzSampler designed_sampler(map, 0);
+    FuzzSampler golden_sampler(map, 1);
+    map.clear();
+    Lockstep<DesignedAdapter, GoldenAdapter<sCPUMain> > lockstep(designed, golden);
+    for (int cycle = 0; cycle < max_cycles; cycle++) {
+        golden.cover(golden_sampler);   // the golden step of this cycle, sampled
+        designed.cover(designed_sampler);
+        uint64_t designed_state = designed.packedState();
+        uint64_t golden_state = golden.packedState();
+        if (designed_state != golden_state) {
+            reason = "cycle " + std::to_string(cycle) + ": " + describe_mismatch(designed_state, golden_state);
+            return false;
+        }
+        if (lockstep.halted()) {
+            break;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    uint64_t executions = 1000000;
+    uint64_t seed = 1;
+    uint64_t max_cycles = 256;
+    uint64_t save_every = 100000;
+    bool stop_on_failure = false;
+    std::string corpus_path = "fuzz.corpus";
+    std::string failures_path = "fuzz_failures.corpus";
+    for (int i = 1; i < argc; i++) {
+        uint64_t value;
+        std::string text;
+        std::string arg = argv[i];
+        if (parse_option(arg, "executions", value)) {
+            executions = value;
+        } else if (parse_option(arg, "seed", value)) {
+            seed = value;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_cycles = value;
+        } else if (parse_option(arg, "save-every", value)) {
+            save_every = value;
+        } else if (parse_option(arg, "corpus", text)) {
+            corpus_path = text;
+        } else if (parse_option(arg, "failures", text)) {
+            failures_path = text;
+        } else if (arg == "--stop-on-failure") {
+            stop_on_failure = true;
+        } else if (unknown_option(arg)) {
+            return 1;
+        }
+    }
+
+    std::cout << "Coverage-Guided Fuzzing (Designed CPU vs Golden CPU)\n";
+    std::cout << "====================================================\n\n";
+
+    Fuzzer fuzzer(seed);
+    if (!fuzzer.load(corpus_path)) {
+        return 1;
+    }
+    std::cout << "Corpus: " << corpus_path << " (" << fuzzer.corpus().size() << " programs), "
+              << executions << " executions, cycle cap " << max_cycles << "\n\n";
+
+    std::unique_ptr<VerilatedContext> contextp(new VerilatedContext);
+    std::unique_ptr<Vmain> designed_cpu(new Vmain(contextp.get()));
+    designed_cpu->clk = 0;
+    designed_cpu->reset = 0;
+    designed_cpu->eval();   // initial block first, then every program replaces the ROM
+
+    // Corpus seeds first, so a resumed session starts with their coverage
+    FuzzMap map;
+    std::vector<std::vector<uint8_t> > seeds = fuzzer.corpus();
+    std::string reason;
+    for (const std::vector<uint8_t>& program : seeds) {
+        fuzz_one(*designed_cpu, program, max_cycles, map, reason);
+        map.update();
+    }
+
+    CorpusWriter failures;
+    std::set<std::vector<uint8_t> > failing;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t done = 0;
+    for (; done < executions; done++) {
+        std::vector<uint8_t> program = fuzzer.next();
+        bool passed = fuzz_one(*designed_cpu, program, max_cycles, map, reason);
+        fuzzer.report(program, map);
+
+        if (!passed && failing.insert(program).second) {
+            if (failing.size() == 1 && !failures.open(failures_path, FUZZ_ROM_SIZE, false)) {
+                return 1;
+            }
+            failures.append(program.data(), nullptr);
+            if (failing.size() <= 10) {
+                std::cout << "  err execution " << done << ", " << reason << "\n    ROM:";
+                for (uint8_t byte : program) {
+                    std::cout << " " << std::hex << std::setw(2) << std::setfill('0') << (int)byte << std::dec << std::setfill(' ');
+                }
+                std::cout << "\n";
+            }
+            if (stop_on_failure) {
+                done++;
+                break;
+            }
+        }
+        if (save_every > 0 && (done + 1) % save_every == 0) {
+            fuzzer.save(corpus_path);
+            std::cout << "  " << done + 1 << " executions, corpus " << fuzzer.corpus().size() << ", "
+                      << map.covered() << " coverage buckets, " << failing.size() << " failing programs\n";
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!fuzzer.save(corpus_path)) {
+        return 1;
+    }
+    failures.close();
+    designed_cpu->final();
+
+    std::cout << "\nRan " << done << " programs in " << std::fixed << std::setprecision(2) << seconds << " s ("
+              << (uint64_t)(done / std::max(seconds, 1e-9)) << " programs/s), " << fuzzer.stats().kept
+              << " kept, corpus " << fuzzer.corpus().size() << " programs, " << map.covered() << " coverage buckets\n";
+    if (failing.empty()) {
+        std::cout << "\nok No divergent program found\n";
+        return 0;
+    }
+    std::cout << "\nerr " << failing.size() << " divergent programs (in " << failures_path << ")\n";
+    return 1;
+}
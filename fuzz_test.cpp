@@ -0,0 +1,230 @@
+// Coverage-guided fuzzer on golden models: sCPUMain against a stand-in for main.sv that
+// branches on r0 > rs2 (the RTL's BNER0) instead of rs2 != r0.
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "fuzz.h"
+#include "lockstep.h"
+#include "sCPU.h"
+
+// sCPUMain with the RTL's branch condition; halts like VerilatedAdapter
+class GreaterBranchAdapter {
+    public:
+        explicit GreaterBranchAdapter(sCPUMain& cpu) : cpu_(cpu) {}
+
+        void step() {
+            uint8_t pc = this->cpu_.getPc();
+            const sCPUMain::MicroOp op = sCPUMain::decode(this->cpu_.fetchInstruction(pc));
+            if (op.kind == sCPU::OP_BNER0) {
+                this->cpu_.setPc(taken(op) ? op.target : pc + 1);
+            } else {
+                uint8_t written_reg, written_value;
+                this->cpu_.executeInstruction(written_reg, written_value);
+            }
+        }
+
+        template <typename Sink>
+        void cover(Sink& sink) {
+            uint8_t pc = this->cpu_.getPc();
+            uint8_t instruction = this->cpu_.fetchInstruction(pc);
+            const sCPUMain::MicroOp op = sCPUMain::decode(instruction);
+            CoverageEvent event = {};
+            event.pc = pc;
+            event.kind = op.kind;
+            event.rd = (instruction >> sCPUMain::FIELD_BITS) & (sCPUMain::REGISTER_COUNT - 1);
+            event.rs1 = op.rs1;
+            event.rs2 = op.rs2;
+            if (op.kind == sCPU::OP_ADD) {
+                coverage_add_flags(this->cpu_.getRegister(op.rs1), this->cpu_.getRegister(op.rs2), event);
+            } else if (op.kind == sCPU::OP_BNER0) {
+                event.taken = taken(op);
+                event.branch_to_self = op.target == pc;
+            }
+            step();
+            event.next_pc = this->cpu_.getPc();
+            event.pc_wrapped = !event.taken && event.next_pc < pc;
+            sink.sample(event);
+        }
+
+        uint64_t packedState() {
+            return this->cpu_.getPackedState();
+        }
+
+        bool halted() {
+            uint8_t pc = this->cpu_.getPc();
+            const sCPUMain::MicroOp op = sCPUMain::decode(this->cpu_.fetchInstruction(pc));
+            return (op.kind == sCPU::OP_BNER0 && op.target == pc && taken(op)) || this->cpu_.isHalted();
+        }
+
+    private:
+        bool taken(const sCPUMain::MicroOp& op) {
+            return this->cpu_.getRegister(0) > this->cpu_.getRegister(op.rs2);
+        }
+
+        sCPUMain& cpu_;
+};
+
+// Lockstep of one program with both models sampling into map; true if they agree.
+// fault selects the designed stand-in (false: sCPUMain on both sides)
+bool execute(const std::vector<uint8_t>& program, FuzzMap& map, bool fault = true) {
+    sCPUMain designed_cpu, golden_cpu;
+    designed_cpu.loadInstructions(program);
+    golden_cpu.loadInstructions(program);
+    GreaterBranchAdapter faulty(designed_cpu);
+    GoldenAdapter<sCPUMain> correct(designed_cpu);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+    FuzzSampler designed_sampler(map, 0);
+    FuzzSampler golden_sampler(map, 1);
+    map.clear();
+    for (int cycle = 0; cycle < 256; cycle++) {
+        if (fault) {
+            faulty.cover(designed_sampler);
+        } else {
+            correct.cover(designed_sampler);
+        }
+        golden.cover(golden_sampler);
+        if (designed_cpu.getPackedState() != golden_cpu.getPackedState()) {
+            return false;
+        }
+        if ((fault ? faulty.halted() : correct.halted()) && golden.halted()) {
+            break;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "Testing coverage-guided fuzzer\n";
+    std::cout << "==============================\n\n";
+
+    // Test 1: hit counts are new once per bucket
+    std::cout << "Test 1: Hit-count buckets\n";
+    FuzzMap buckets;
+    const int counts[] = { 1, 1, 2, 3, 3, 5, 7, 8, 200, 255 };
+    const int fresh[] = { 1, 0, 1, 1, 0, 1, 0, 1, 1, 0 };
+    for (int i = 0; i < 10; i++) {
+        buckets.clear();
+        for (int c = 0; c < counts[i]; c++) {
+            buckets.hit(42);
+        }
+        if (buckets.update() != fresh[i]) {
+            std::cerr << "  ✗ FAIL: " << counts[i] << " hits: expected " << (fresh[i] ? "new" : "nothing new") << "\n";
+            return 1;
+        }
+    }
+    if (buckets.covered() != 6) {
+        std::cerr << "  ✗ FAIL: " << buckets.covered() << " buckets covered\n";
+        return 1;
+    }
+    std::cout << "  ✓ 1, 2, 3, 4-7, 8-15, 128+ each new once\n\n";
+
+    // Test 2: mutants keep the ROM size and differ from their parent
+    std::cout << "Test 2: Mutations\n";
+    Fuzzer mutator(1);
+    std::vector<uint8_t> parent(FUZZ_ROM_SIZE);
+    for (int i = 0; i < FUZZ_ROM_SIZE; i++) {
+        parent[i] = 0x11 * i;   // all slots distinct
+    }
+    mutator.addSeed(parent);
+    int changed = 0;
+    for (int i = 0; i < 10000; i++) {
+        std::vector<uint8_t> mutant = mutator.next();
+        if (mutant.size() != (size_t)FUZZ_ROM_SIZE) {
+            std::cerr << "  ✗ FAIL: mutant of " << mutant.size() << " bytes\n";
+            return 1;
+        }
+        changed += mutant != parent;
+    }
+    if (changed < 9000) {
+        std::cerr << "  ✗ FAIL: only " << changed << " of 10000 mutants differ\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << changed << " of 10000 mutants differ from the seed\n\n";
+
+    // Test 3: more feedback than random programs on the same budget (fault-free models)
+    const int BUDGET = 20000;
+    std::cout << "Test 3: Guided vs random, " << BUDGET << " executions\n";
+    Fuzzer fuzzer(3);
+    FuzzMap guided_map;
+    for (int i = 0; i < BUDGET; i++) {
+        std::vector<uint8_t> program = fuzzer.next();
+        execute(program, guided_map, false);
+        fuzzer.report(program, guided_map);
+    }
+    FuzzMap random_map;
+    std::mt19937 rng(3);
+    for (int i = 0; i < BUDGET; i++) {
+        std::vector<uint8_t> program(FUZZ_ROM_SIZE);
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        execute(program, random_map, false);
+        random_map.update();
+    }
+    if (fuzzer.stats().executions != (uint64_t)BUDGET || guided_map.covered() <= random_map.covered()) {
+        std::cerr << "  ✗ FAIL: guided " << guided_map.covered() << " buckets, random " << random_map.covered() << "\n";
+        return 1;
+    }
+    std::cout << "  ✓ guided " << guided_map.covered() << " buckets (" << fuzzer.corpus().size()
+              << " corpus programs), random " << random_map.covered() << "\n\n";
+
+    // Test 4: replaying the corpus reproduces all feedback (every new find was kept)
+    std::cout << "Test 4: Corpus replay reproduces the coverage\n";
+    FuzzMap replay_map;
+    for (const std::vector<uint8_t>& program : fuzzer.corpus()) {
+        execute(program, replay_map, false);
+        replay_map.update();
+    }
+    if (replay_map.covered() != guided_map.covered()) {
+        std::cerr << "  ✗ FAIL: replay " << replay_map.covered() << " buckets, fuzzing " << guided_map.covered() << "\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << replay_map.covered() << " buckets from " << fuzzer.corpus().size() << " programs\n\n";
+
+    // Test 5: persistent corpus
+    std::cout << "Test 5: Corpus file save / load\n";
+    const char* path = "fuzz_test.corpus";
+    std::remove(path);
+    Fuzzer reloaded(5);
+    if (!reloaded.load(path) || !reloaded.corpus().empty() || !fuzzer.save(path) || !reloaded.load(path)
+        || reloaded.corpus() != fuzzer.corpus()) {
+        std::cerr << "  ✗ FAIL: corpus not restored\n";
+        std::remove(path);
+        return 1;
+    }
+    std::remove(path);
+    std::cout << "  ✓ missing file is an empty corpus, " << reloaded.corpus().size() << " programs restored\n\n";
+
+    // Test 6: the RTL-style branch divergence is found by mutation. Only agreeing programs
+    // are reported, so every corpus entry agrees and a divergent mutant reached the branch
+    // from a parent that did not; divergent fresh random programs are skipped.
+    std::cout << "Test 6: Mutation finds the r0 > rs2 vs rs2 != r0 divergence\n";
+    Fuzzer hunter(6);
+    FuzzMap hunt_map;
+    int found_at = -1;
+    int fresh_divergent = 0;
+    for (int i = 0; i < BUDGET && found_at < 0; i++) {
+        uint64_t mutants = hunter.stats().mutants;
+        std::vector<uint8_t> program = hunter.next();
+        bool mutant = hunter.stats().mutants != mutants;
+        if (execute(program, hunt_map)) {
+            hunter.report(program, hunt_map);
+        } else if (mutant) {
+            found_at = i;
+        } else {
+            fresh_divergent++;
+        }
+    }
+    if (found_at < 0 || hunter.corpus().empty()) {
+        std::cerr << "  ✗ FAIL: no divergent mutant in " << BUDGET << " executions\n";
+        return 1;
+    }
+    std::cout << "  ✓ divergent mutant of an agreeing corpus entry after " << found_at + 1 << " executions ("
+              << hunter.corpus().size() << " corpus programs, " << fresh_divergent << " fresh divergent skipped)\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,20 @@
+g++ -O2 -std=c++17 fuzz_test.cpp fuzz.cpp corpus.cpp coverage.cpp sCPU.cpp -o fuzz_test
+./fuzz_test
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe fuzz_rtl.cpp campaign.cpp corpus.cpp coverage.cpp fuzz.cpp sCPU.cpp \
+  --trace \
+  -CFLAGS "-O2"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain --executions=200000 --seed=1 --corpus=fuzz.corpus
@@ -1,10 +1,13 @@
-module immediate_extend(
-    input logic [3:0] imm_in,
+module immediate_extend #(
+    parameter IMM_WIDTH = 4,
+    parameter DATA_WIDTH = 8
+)(
+    input logic [IMM_WIDTH-1:0] imm_in,
     // input logic sign_extend, // 1 - sign-extend, 0 - zero-extend
 
-    output logic [7:0] imm_out
+    output logic [DATA_WIDTH-1:0] imm_out
 );
     always_comb begin
-        imm_out = {4'b0000, imm_in}; // zero-extend by default
+        imm_out = DATA_WIDTH'(imm_in); // zero-extend by default (truncates if DATA_WIDTH < IMM_WIDTH)
     end
 endmodule
@@ -1,14 +1,26 @@
-module instruction_memory(
-    input logic [3:0] address,
-    output logic [7:0] instruction
+module instruction_memory #(
+    parameter ADDR_WIDTH = 4,   // 2**ADDR_WIDTH instructions
+    parameter INSTR_WIDTH = 8
+)(
+    input logic [ADDR_WIDTH-1:0] address,
+    output logic [INSTR_WIDTH-1:0] instruction
 );
 
-    // Simple instruction memory with 16 instructions (4-bit address)
-    logic [7:0] memory [0:15];
+    // Simple instruction memory, by default 16 instructions of 8 bits (4-bit address)
+    // Public so C++ testbenches can load other programs after the initial block ran
+    logic [INSTR_WIDTH-1:0] memory [0:(1<<ADDR_WIDTH)-1] /* verilator public_flat_rw */;
 
-    // Initialize the instruction memory with example program:
+    // Program image file given at runtime (+rom=<file>, $readmemb format: one 8-bit
+    // binary word per line, // comments), so a new program needs no re-verilation
+    string rom_path;
+
+    // Initialize the instruction memory with example program (default 8-bit encoding only):
     // Program: Load immediates, add them, and loop
     initial begin
+        for (int i = 0; i < (1 << ADDR_WIDTH); i++) begin
+            memory[i] = '0;
+        end
+
         // Format: [opcode(2) | fields...]
         // Opcode: 00=ADD, 10=LI, 11=BNER0
         /*
@@ -22,22 +34,24 @@ module instruction_memory(
         11011111    # 7: bner0 r3, 7
         */
         
-        memory[0]  = 8'b10001010;  // li r0, 10     (Load 10 into r0)
-        memory[1]  = 8'b10010000;  // li r1, 0     (Load 0 into r1)
-        memory[2]  = 8'b10100000;  // li r2, 0     (Load 0 into r2)
-        memory[3]  = 8'b10110001;  // li r3, 1     (Load 1 into r3)
-        memory[4]  = 8'b00010111;  // add r1, r1, r3  (r1 = r1 + r3)
-        memory[5]  = 8'b00101001;  // add r2, r2, r1  (r2 = r2 + r1)
-        memory[6]  = 8'b11010001;  // bner0 r1, 4  (Branch to 4 if r1≠0)
-        memory[7]  = 8'b11011111;  // bner0 r3, 7  (Branch to 7 if r3≠0)
-        memory[8]  = 8'b00000000;
-        memory[9]  = 8'b00000000;
-        memory[10] = 8'b00000000;
-        memory[11] = 8'b00000000;
-        memory[12] = 8'b00000000;
-        memory[13] = 8'b00000000;
-        memory[14] = 8'b00000000;
-        memory[15] = 8'b00000000;
+        if (INSTR_WIDTH == 8 && ADDR_WIDTH >= 3) begin
+            memory[0][7:0] = 8'b10001010;  // li r0, 10     (Load 10 into r0)
+            memory[1][7:0] = 8'b10010000;  // li r1, 0     (Load 0 into r1)
+            memory[2][7:0] = 8'b10100000;  // li r2, 0     (Load 0 into r2)
+            memory[3][7:0] = 8'b10110001;  // li r3, 1     (Load 1 into r3)
+            memory[4][7:0] = 8'b00010111;  // add r1, r1, r3  (r1 = r1 + r3)
+            memory[5][7:0] = 8'b00101001;  // add r2, r2, r1  (r2 = r2 + r1)
+            memory[6][7:0] = 8'b11010001;  // bner0 r1, 4  (Branch to 4 if r1≠0)
+            memory[7][7:0] = 8'b11011111;  // bner0 r3, 7  (Branch to 7 if r3≠0)
+        end
+
+        // Runtime image replaces the example program; words past its end stay 0 (add r0, r0, r0)
+        if ($value$plusargs("rom=%s", rom_path)) begin
+            for (int i = 0; i < (1 << ADDR_WIDTH); i++) begin
+                memory[i] = '0;
+            end
+            $readmemb(rom_path, memory);
+        end
     end
 
     // Read instruction from memory based on address
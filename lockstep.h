@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "commitlog.h"
+#include "coverage.h"
+#include "sCPU.h"
+
+// Generic lockstep engine: clocks a designed model and a golden model together and
+// compares their architectural state as one packed 64-bit word per cycle.
+//
+// A model adapter provides:
+//   void step();               advance one instruction / clock cycle
+//   uint64_t packedState();    architectural state in the layout below
+//   bool halted();             model reports termination (see sCPU::isHalted)
+// and, to write a commit log (commitlog.h) instead of running in lockstep:
+//   void commit(CommitRecord&); step, describing the retired instruction
+// and, for functional coverage (coverage.h):
+//   void cover(Sink&);          step, sampling the retired instruction (CoverageEvent)
+//
+// Packed state layout:
+//   bits  7:0   PC (zero-extended)
+//   bits 15:8   R0
+//   bits 23:16  R1
+//   bits 31:24  R2
+//   bits 39:32  R3
+
+inline uint64_t pack_state(uint8_t pc, const uint8_t regs[4]) {
+    return (uint64_t)pc | ((uint64_t)regs[0] << 8) | ((uint64_t)regs[1] << 16)
+         | ((uint64_t)regs[2] << 24) | ((uint64_t)regs[3] << 32);
+}
+
+inline uint8_t packed_pc(uint64_t state) {
+    return state & 0xFF;
+}
+
+inline uint8_t packed_register(uint64_t state, int index) {
+    return (state >> (8 + 8 * index)) & 0xFF;
+}
+
+// Field-by-field description of a mismatch, e.g. "PC designed 3 golden 4, R1 designed 7 golden 9"
+inline std::string describe_mismatch(uint64_t designed_state, uint64_t golden_state) {
+    std::ostringstream text;
+    if (packed_pc(designed_state) != packed_pc(golden_state)) {
+        text << "PC designed " << (int)packed_pc(designed_state) << " golden " << (int)packed_pc(golden_state);
+    }
+    for (int i = 0; i < 4; i++) {
+        if (packed_register(designed_state, i) != packed_register(golden_state, i)) {
+            text << (text.tellp() != 0 ? ", " : "") << "R" << i
+                 << " designed " << (int)packed_register(designed_state, i)
+                 << " golden " << (int)packed_register(golden_state, i);
+        }
+    }
+    return text.str();
+}
+
+// Adapter for golden models with the sCPU interface (any sCPUSized, sCPUCompiled); instructions
+// are decoded with CPU::decode and the CPU's own field widths. The observers (packed state,
+// CommitRecord, CoverageEvent / CoverageShard) hold main.sv's state, so they are only
+// available for configurations with at most an 8-bit PC, 4 registers and 8-bit data.
+template <typename CPU>
+class GoldenAdapter {
+    public:
+        static constexpr bool OBSERVABLE = CPU::PC_WIDTH <= 8 && CPU::REGISTER_COUNT == COVERAGE_REGISTERS
+                                        && CPU::DATA_WIDTH == 8;
+
+        explicit GoldenAdapter(CPU& cpu) : cpu_(cpu) {}
+
+        void step() {
+            uint8_t written_reg, written_value;
+            this->cpu_.executeInstruction(written_reg, written_value);
+        }
+
+        // Step, and describe the retired instruction in record (cycle is left to the caller)
+        void commit(CommitRecord& record) {
+            static_assert(OBSERVABLE, "CommitRecord holds an 8-bit PC, 2-bit rd and 8-bit value");
+            record.pc = this->cpu_.getPc();
+            const typename CPU::MicroOp op = CPU::decode(this->cpu_.fetchInstruction(record.pc));
+            record.branch_taken = op.kind == CPU::OP_BNER0
+                               && this->cpu_.getRegister(op.rs2) != this->cpu_.getRegister(0);
+            record.written = this->cpu_.executeInstruction(record.rd, record.value);
+            if (!record.written) {
+                record.rd = 0;
+                record.value = 0;
+            }
+        }
+
+        // Step, sampling the retired instruction into sink (CoverageShard, FuzzSampler)
+        template <typename Sink>
+        void cover(Sink& sink) {
+            static_assert(OBSERVABLE, "coverage points are laid out for 4 registers, 8-bit data and PC");
+            uint32_t pc = this->cpu_.getPc();
+            uint32_t instruction = this->cpu_.fetchInstruction(pc);
+            const typename CPU::MicroOp op = CPU::decode(instruction);
+            CoverageEvent event = {};
+            event.pc = pc;
+            event.kind = op.kind;
+            event.rd = (instruction >> CPU::FIELD_BITS) & (CPU::REGISTER_COUNT - 1);   // raw field, BNER0 too
+            if (op.kind == CPU::OP_ADD) {
+                event.rs1 = op.rs1;
+                event.rs2 = op.rs2;
+                coverage_add_flags(this->cpu_.getRegister(op.rs1), this->cpu_.getRegister(op.rs2), event);
+            } else if (op.kind == CPU::OP_BNER0) {
+                event.rs2 = op.rs2;
+                event.taken = this->cpu_.getRegister(op.rs2) != this->cpu_.getRegister(0);
+                event.branch_to_self = op.target == pc;
+            }
+            step();
+            event.next_pc = this->cpu_.getPc();
+            event.pc_wrapped = !event.taken && event.next_pc < pc;
+            sink.sample(event);
+        }
+
+        uint64_t packedState() {
+            static_assert(OBSERVABLE, "packed state holds an 8-bit PC and R0..R3 of 8 bits");
+            return this->cpu_.getPackedState();
+        }
+
+        bool halted() {
+            return this->cpu_.isHalted();
+        }
+
+        CPU& cpu() {
+            return this->cpu_;
+        }
+
+    private:
+        CPU& cpu_;
+};
+
+template <typename Designed, typename Golden>
+class Lockstep {
+    public:
+        Lockstep(Designed& designed, Golden& golden)
+            : designed_(designed), golden_(golden), cycle_(0) {
+            this->designed_state_ = designed.packedState();
+            this->golden_state_ = golden.packedState();
+        }
+
+        // Clock both models once; true if the states match (a single integer compare)
+        bool step() {
+            this->designed_.step();
+            this->golden_.step();
+            this->cycle_++;
+            this->designed_state_ = this->designed_.packedState();
+            this->golden_state_ = this->golden_.packedState();
+            return this->designed_state_ == this->golden_state_;
+        }
+
+        // Same, sampling the designed model's coverage of the cycle into sink
+        template <typename Sink>
+        bool step(Sink& sink) {
+            this->designed_.cover(sink);
+            this->golden_.step();
+            this->cycle_++;
+            this->designed_state_ = this->designed_.packedState();
+            this->golden_state_ = this->golden_.packedState();
+            return this->designed_state_ == this->golden_state_;
+        }
+
+        // Re-read both states after the models were restored from a checkpoint (checkpoint.h),
+        // continuing the cycle count at cycle
+        void restart(uint64_t cycle) {
+            this->cycle_ = cycle;
+            this->designed_state_ = this->designed_.packedState();
+            this->golden_state_ = this->golden_.packedState();
+        }
+
+        // Both models report termination
+        bool halted() {
+            return this->designed_.halted() && this->golden_.halted();
+        }
+
+        uint64_t cycle() const { return this->cycle_; }
+        uint64_t designedState() const { return this->designed_state_; }
+        uint64_t goldenState() const { return this->golden_state_; }
+
+        Designed& designed() { return this->designed_; }
+        Golden& golden() { return this->golden_; }
+
+    private:
+        Designed& designed_;
+        Golden& golden_;
+        uint64_t cycle_;
+        uint64_t designed_state_;
+        uint64_t golden_state_;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <verilated.h>
+#include "lockstep.h"
+
+// Trace type for models built without --trace
+struct NoTrace {
+    void dump(uint64_t) {}
+};
+
+// Lockstep adapter for Verilated CPU models. Any top module with clk / reset inputs and
+// the packed state_debug / halt_debug / pc_debug (and for commit logs commit_debug) ports
+// of main.sv can be plugged in.
+// Trace is the waveform writer (e.g. VerilatedVcdC), NoTrace when the model has no tracing.
+template <typename VModel, typename Trace = NoTrace>
+class VerilatedAdapter {
+    public:
+        // tfp may be null (no tracing)
+        explicit VerilatedAdapter(VModel& model, Trace* tfp = nullptr)
+            : model_(model), tfp_(tfp), time_(0) {}
+
+        // One full clock cycle (both edges dumped to the trace)
+        void clock() {
+            this->model_.clk = 0;
+            this->model_.eval();
+            if (this->tfp_ != nullptr) {
+                this->tfp_->dump(this->time_);
+            }
+            this->time_++;
+
+            this->model_.clk = 1;
+            this->model_.eval();
+            if (this->tfp_ != nullptr) {
+                this->tfp_->dump(this->time_);
+            }
+            this->time_++;
+        }
+
+        // Hold reset for cycles clock cycles
+        void reset(int cycles = 2) {
+            this->model_.reset = 1;
+            for (int i = 0; i < cycles; i++) {
+                clock();
+            }
+            this->model_.reset = 0;
+        }
+
+        void step() {
+            clock();
+        }
+
+        // Step, and describe the retired instruction in record (cycle is left to the caller).
+        // commit_debug is combinational on the instruction at PC, so it is sampled before the edge.
+        void commit(CommitRecord& record) {
+            uint16_t commit = this->model_.commit_debug;
+            record.pc = this->model_.pc_debug;
+            record.written = (commit >> 10) & 1;
+            record.rd = record.written ? (commit >> 8) & 3 : 0;
+            record.value = record.written ? commit & 0xFF : 0;
+            record.branch_taken = (commit >> 11) & 1;
+            clock();
+        }
+
+        // Step, sampling the RTL control path (cover_debug) into sink: the decoded fields,
+        // the branch decision and the ALU carry / overflow of the instruction at PC
+        template <typename Sink>
+        void cover(Sink& sink) {
+            uint16_t cover = this->model_.cover_debug;
+            uint8_t pc = this->model_.pc_debug;
+            CoverageEvent event;
+            event.pc = pc;
+            event.kind = (cover >> 10) & 3;
+            event.rd = (cover >> 8) & 3;
+            event.rs1 = (cover >> 6) & 3;
+            event.rs2 = (cover >> 4) & 3;
+            event.branch_to_self = (cover >> 3) & 1;
+            event.taken = (cover >> 2) & 1;
+            event.carry = (cover >> 1) & 1;
+            event.overflow = cover & 1;
+            clock();
+            event.next_pc = this->model_.pc_debug;
+            event.pc_wrapped = !event.taken && event.next_pc < pc;
+            sink.sample(event);
+        }
+
+        uint64_t packedState() {
+            return this->model_.state_debug;
+        }
+
+        // main.sv's halt_debug: the instruction at PC is a taken branch to itself
+        bool halted() {
+            return this->model_.halt_debug;
+        }
+
+        VModel& model() {
+            return this->model_;
+        }
+
+        uint64_t time() const {
+            return this->time_;
+        }
+
+        // Continue the edge count of a restored checkpoint (checkpoint_verilated.h)
+        void setTime(uint64_t time) {
+            this->time_ = time;
+        }
+
+    private:
+        VModel& model_;
+        Trace* tfp_;
+        uint64_t time_;
+};
@@ -4,62 +4,79 @@ Integrates all components into a functional processor
 
 Architecture:
 - Von Neumann style (single memory for instructions)
-- 4-bit PC, 8-bit data path
+- 4-bit PC, 8-bit data path, 4 registers by default (parameters PC_WIDTH, REGISTERS,
+  DATA_WIDTH; instructions widen to 2 + log2(REGISTERS) + max(PC_WIDTH, 2 * log2(REGISTERS))
+  bits, see sCPUSized<> in sCPU.h for the matching golden model)
 - 3 instruction types:
   * 00: ADD/SUB (R-type)
   * 10: LI (Load Immediate)
   * 11: BNER0 (Branch if Not Equal to R0)
 */
 
-module main(
+module main #(
+    parameter PC_WIDTH = 4,     // 2**PC_WIDTH ROM entries, PC wraps to 0 after the last one
+    parameter REGISTERS = 4,    // power of two, at least 4
+    parameter DATA_WIDTH = 8,
+    localparam REG_BITS = $clog2(REGISTERS),
+    localparam FIELD_WIDTH = PC_WIDTH > 2 * REG_BITS ? PC_WIDTH : 2 * REG_BITS,
+    localparam INSTR_WIDTH = 2 + REG_BITS + FIELD_WIDTH
+)(
     input logic clk,
     input logic reset,
     // Debug outputs for testing
-    output logic [3:0] pc_debug,
-    output logic [7:0] reg0_debug,
-    output logic [7:0] reg1_debug,
-    output logic [7:0] reg2_debug,
-    output logic [7:0] reg3_debug
+    output logic [PC_WIDTH-1:0] pc_debug,
+    output logic [DATA_WIDTH-1:0] reg0_debug,
+    output logic [DATA_WIDTH-1:0] reg1_debug,
+    output logic [DATA_WIDTH-1:0] reg2_debug,
+    output logic [DATA_WIDTH-1:0] reg3_debug,
+    output logic halt_debug,       // Taken branch to itself: state can no longer change
+    output logic [4*DATA_WIDTH+7:0] state_debug, // Packed {R3, R2, R1, R0, PC (low 8 bits)} for single-word comparison
+    output logic [DATA_WIDTH+REG_BITS+1:0] commit_debug, // {branch taken, write enable, rd, write data} of the instruction at PC
+    output logic [3*REG_BITS+5:0] cover_debug  // {opcode, rd field, rs1, rs2, branch to self, branch taken, ADD carry, ADD overflow} (coverage.h)
 );
 
     // ========== Signals ==========
     
     // Program Counter
-    logic [3:0] pc_out;
+    logic [PC_WIDTH-1:0] pc_out;
     logic [1:0] pc_opcode;
-    logic [3:0] pc_set_value;
+    logic [PC_WIDTH-1:0] pc_set_value;
     
     // Instruction Memory
-    logic [7:0] instruction;
+    logic [INSTR_WIDTH-1:0] instruction;
     
     // Control Unit
     logic [1:0] opcode;
-    logic [1:0] rd, rs1, rs2;
-    logic [3:0] imm;
-    logic [3:0] branch_addr;
+    logic [REG_BITS-1:0] rd, rs1, rs2;
+    logic [FIELD_WIDTH-1:0] imm;
+    logic [FIELD_WIDTH-1:0] branch_addr;
     
     // Register File
-    logic reg_we;                  // Write enable
-    logic [7:0] reg_wd;            // Write data (8 bits)
-    logic [7:0] reg_rs1_data;      // Read data from rs1 (8 bits)
-    logic [7:0] reg_rs2_data;      // Read data from rs2 (8 bits)
-    logic [7:0] reg_rd_data;       // Read data from rd (8 bits)
+    logic reg_we;                         // Write enable
+    logic [DATA_WIDTH-1:0] reg_wd;        // Write data
+    logic [DATA_WIDTH-1:0] reg_rs1_data;  // Read data from rs1
+    logic [DATA_WIDTH-1:0] reg_rs2_data;  // Read data from rs2
+    logic [DATA_WIDTH-1:0] reg_rd_data;   // Read data from rd
     
     // Immediate Extend
-    logic [7:0] imm_extended;
+    logic [DATA_WIDTH-1:0] imm_extended;
     
     // ALU
-    logic [7:0] alu_operand_a;
-    logic [7:0] alu_operand_b;
+    logic [DATA_WIDTH-1:0] alu_operand_a;
+    logic [DATA_WIDTH-1:0] alu_operand_b;
     logic [1:0] alu_op;
-    logic [7:0] alu_result;
+    logic [DATA_WIDTH-1:0] alu_result;
     logic alu_zero_flag;
+
+    // ADD carry-out / signed overflow, for coverage only
+    logic [DATA_WIDTH:0] add_wide;
+    logic add_carry, add_overflow;
     
     
     // ========== Component Instantiation ==========
     
     // 1. Program Counter
-    program_counter pc_inst (
+    program_counter #(.PC_WIDTH(PC_WIDTH)) pc_inst (
         .clk(clk),
         .reset(reset),
         .opcode(pc_opcode),
@@ -68,13 +85,13 @@ module main(
     );
     
     // 2. Instruction Memory (ROM)
-    instruction_memory imem_inst (
+    instruction_memory #(.ADDR_WIDTH(PC_WIDTH), .INSTR_WIDTH(INSTR_WIDTH)) imem_inst (
         .address(pc_out),
         .instruction(instruction)
     );
     
     // 3. Control Unit (Instruction Decoder)
-    control_unit cu_inst (
+    control_unit #(.REG_BITS(REG_BITS), .FIELD_WIDTH(FIELD_WIDTH)) cu_inst (
         .instruction(instruction),
         .opcode(opcode),
         .rd(rd),
@@ -85,14 +102,15 @@ module main(
     );
     
     // 4. Immediate Extend
-    immediate_extend imm_ext_inst (
+    immediate_extend #(.IMM_WIDTH(FIELD_WIDTH), .DATA_WIDTH(DATA_WIDTH)) imm_ext_inst (
         .imm_in(imm),
         .imm_out(imm_extended)
     );
     
     // 5. Register File
-    register_file regfile_inst (
+    register_file #(.REGISTERS(REGISTERS), .DATA_WIDTH(DATA_WIDTH)) regfile_inst (
         .clk(clk),
+        .reset(reset),
         .we(reg_we),
         .rd(rd),
         .rs1(rs1),
@@ -108,7 +126,7 @@ module main(
     );
     
     // 6. ALU
-    alu alu_inst (
+    alu #(.DATA_WIDTH(DATA_WIDTH)) alu_inst (
         .operand_a(alu_operand_a),
         .operand_b(alu_operand_b),
         .alu_op(alu_op),
@@ -119,18 +137,29 @@ module main(
     
     // ========== Debug Outputs ==========
     assign pc_debug = pc_out;
+    assign state_debug = {reg3_debug, reg2_debug, reg1_debug, reg0_debug, 8'(pc_out)};
+    assign commit_debug = {pc_opcode == 2'b11, reg_we, rd, reg_wd};
+    assign halt_debug = (opcode == 2'b11) && (pc_opcode == 2'b11) && (pc_set_value == pc_out);
+
+    assign add_wide = {1'b0, reg_rs1_data} + {1'b0, reg_rs2_data};
+    assign add_carry = (opcode == 2'b00) && add_wide[DATA_WIDTH];
+    assign add_overflow = (opcode == 2'b00) && (reg_rs1_data[DATA_WIDTH-1] == reg_rs2_data[DATA_WIDTH-1])
+                          && (add_wide[DATA_WIDTH-1] != reg_rs1_data[DATA_WIDTH-1]);
+    assign cover_debug = {opcode, instruction[INSTR_WIDTH-3:FIELD_WIDTH], rs1, rs2,
+                          (opcode == 2'b11) && (branch_addr[PC_WIDTH-1:0] == pc_out),
+                          pc_opcode == 2'b11, add_carry, add_overflow};
     
     // ========== Control Logic ==========
     
     always_comb begin
         // Default values
         reg_we = 0;
-        reg_wd = 0;
+        reg_wd = '0;
         alu_op = 2'b00;
-        alu_operand_a = 0;
-        alu_operand_b = 0;
+        alu_operand_a = '0;
+        alu_operand_b = '0;
         pc_opcode = 2'b00;      // Normal increment
-        pc_set_value = 0;
+        pc_set_value = '0;
         
         case (opcode)
             2'b00: begin
@@ -158,7 +187,7 @@ module main(
                 // Compare r0 (rd_out) against rs2 to decide branch
                 if (reg_rd_data > reg_rs2_data) begin
                     pc_opcode = 2'b11;          // Enable branch
-                    pc_set_value = branch_addr; // Set PC to branch target
+                    pc_set_value = branch_addr[PC_WIDTH-1:0]; // Set PC to branch target
                 end else begin
                     pc_opcode = 2'b00;          // Normal increment
                 end
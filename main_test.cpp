@@ -1,75 +1,116 @@
+// Options:
+//   +rom=FILE             run this ROM image (rom_image.h text format) instead of the
+//                         example program of instruction_memory.sv, without re-verilating
+//   --trace-ring=N        deferred tracing: keep the last N cycles in memory and write
+//                         waveform_cpu.vcd only when a trigger fires (mismatch or below)
+//   --trigger-pc=P        trigger when PC == P
+//   --trigger-reg=I:V     trigger when register I == V
+//   --trigger-cycles=B:E  record cycles B..E (exclusive)
+//   --trace-store=FILE    full trace of the whole run in a chunked trace store with a cycle
+//                         index (trace_store.h); extract windows with trace_window
+//   --cycles=N            cycle cap (default 1000)
+//   --checkpoint-every=K  keep a checkpoint of both CPUs every K cycles (checkpoint.h)
+//   --checkpoint=FILE     write the last checkpoint before the first mismatch (or the last
+//                         one of the run) to FILE
+//   --restore=FILE        continue from a checkpoint file instead of reset, e.g. to trace
+//                         only the cycles before a mismatch
+//   --soak=K              soak mode (soak.h): run freely, compare a rolling state hash every
+//                         K cycles and bisect a hash mismatch down to the first divergent
+//                         cycle; --checkpoint=FILE then gets the state right before it
+// Without --trace-ring / --trace-store every clock edge is dumped to waveform_cpu.vcd
+// (soak mode does not trace: restore with the written checkpoint to trace the divergence).
+
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <string>
 #include <vector>
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include "Vmain.h"
+#include "Vmain___024root.h"
 #include "sCPU.h"
+#include "sCPUConstexpr.h"
+#include "lockstep_verilated.h"
+#include "options.h"
+#include "checkpoint_verilated.h"
+#include "soak.h"
+#include "trace_ring_verilated.h"
+#include "trace_store_verilated.h"
 
-int clock_cycles = 40;
+// Golden model under comparison: sCPUMain (sized like main.sv, PC wraps from 15 to 0) by
+// default, or the ROM-specialized sCPUCompiled generated by scpu_compile when built with
+// -DSCPU_COMPILED
+#ifdef SCPU_COMPILED
+#include "sCPUCompiled.h"
+typedef sCPUCompiled GoldenCPU;
+#else
+typedef sCPUMain GoldenCPU;
+#endif
 
-void clock_cycle(Vmain* cpu, VerilatedVcdC* tfp, uint64_t& time) {
-    cpu->clk = 0;
-    cpu->eval();
-    tfp->dump(time++);
-    
-    cpu->clk = 1;
-    cpu->eval();
-    tfp->dump(time++);
-}
+// Safety cap: lockstep normally ends as soon as both CPUs halt
+int max_clock_cycles = 1000;
 
-bool compare_cpus(Vmain* designed_cpu, sCPU* golden_cpu, int cycle) {
-    bool match = true;
-    
-    // Compare PC (4-bit value stored in uint8_t)
-    uint8_t designed_pc = designed_cpu->pc_debug;
-    uint8_t golden_pc = golden_cpu->getPc();
-    
-    if (designed_pc != golden_pc) {
+// Example program of instruction_memory.sv and its final state, computed by the compiler
+constexpr uint8_t EXAMPLE_PROGRAM[16] = {
+    0b10001010, 0b10010000, 0b10100000, 0b10110001,
+    0b00010111, 0b00101001, 0b11010001, 0b11011111
+};
+constexpr sCPUMain::RunResult EXAMPLE_RESULT = constexpr_run<sCPUMain>(EXAMPLE_PROGRAM, 1000);
+static_assert(EXAMPLE_RESULT.stop_reason == sCPUMain::STOP_HALT && EXAMPLE_RESULT.pc == 7,
+              "example program halts at PC 7");
+static_assert(EXAMPLE_RESULT.regs[0] == 10 && EXAMPLE_RESULT.regs[1] == 10 && EXAMPLE_RESULT.regs[2] == 55
+              && EXAMPLE_RESULT.regs[3] == 1, "example program computes r2 = 1 + ... + 10 = 55");
+
+// Full VCD of every edge, the deferred ring or the trace store (exactly one of them is set)
+struct WaveformTrace {
+    VerilatedVcdC* vcd = nullptr;
+    TraceRing<Vmain>* ring = nullptr;
+    TraceStore<Vmain>* store = nullptr;
+
+    void dump(uint64_t time) {
+        if (ring != nullptr) {
+            ring->dump(time);
+        } else if (store != nullptr) {
+            store->dump(time);
+        } else {
+            vcd->dump(time);
+        }
+    }
+};
+
+// Designed CPU and golden CPU clocked together by the generic lockstep engine
+typedef VerilatedAdapter<Vmain, WaveformTrace> DesignedAdapter;
+typedef Lockstep<DesignedAdapter, GoldenAdapter<GoldenCPU> > CpuLockstep;
+
+// Field-by-field report, only called when the packed states differ
+void report_mismatch(uint64_t designed_state, uint64_t golden_state, int cycle) {
+    if (packed_pc(designed_state) != packed_pc(golden_state)) {
         std::cout << "  err Cycle " << std::setw(3) << cycle << ": PC mismatch - Designed CPU: " 
-                  << std::setw(3) << (int)designed_pc << ", Golden CPU: " << std::setw(3) << (int)golden_pc << "\n";
-        match = false;
+                  << std::setw(3) << (int)packed_pc(designed_state) << ", Golden CPU: " << std::setw(3) << (int)packed_pc(golden_state) << "\n";
     }
     
     // Compare all registers
     for (int i = 0; i < 4; i++) {
-        uint8_t designed_reg = 0;
-        uint8_t golden_reg = golden_cpu->getRegister(i);
-        
-        // Get register value from hardware CPU
-        switch(i) {
-            case 0: designed_reg = designed_cpu->reg0_debug; break;
-            case 1: designed_reg = designed_cpu->reg1_debug; break;
-            case 2: designed_reg = designed_cpu->reg2_debug; break;
-            case 3: designed_reg = designed_cpu->reg3_debug; break;
-        }
+        uint8_t designed_reg = packed_register(designed_state, i);
+        uint8_t golden_reg = packed_register(golden_state, i);
                 
         if (designed_reg != golden_reg) {
             std::cout << "  err Cycle " << std::setw(3) << cycle << ": R" << i << " mismatch - Designed CPU: " 
                       << std::setw(3) << (int)designed_reg << ", Golden CPU: " << std::setw(3) << (int)golden_reg << "\n";
-            match = false;
         }
     }
-    
-    return match;
 }
 
-void print_state(Vmain* designed_cpu, sCPU* golden_cpu, int cycle) {
+void print_state(uint64_t designed_state, uint64_t golden_state, int cycle) {
     std::cout << "Cycle " << std::setw(3) << cycle << ":\n";
-    std::cout << "  PC:\t\tDesigned CPU: " << std::setw(3) << (int)designed_cpu->pc_debug 
-              << "\tGolden CPU: " << std::setw(3) << (int)golden_cpu->getPc() << "\n";
+    std::cout << "  PC:\t\tDesigned CPU: " << std::setw(3) << (int)packed_pc(designed_state) 
+              << "\tGolden CPU: " << std::setw(3) << (int)packed_pc(golden_state) << "\n";
     std::cout << "  Registers:\n";
     for (int i = 0; i < 4; i++) {
-        uint8_t designed_reg = 0;
-        uint8_t golden_reg = golden_cpu->getRegister(i);
-        
-        // Get register value from hardware CPU
-        switch(i) {
-            case 0: designed_reg = designed_cpu->reg0_debug; break;
-            case 1: designed_reg = designed_cpu->reg1_debug; break;
-            case 2: designed_reg = designed_cpu->reg2_debug; break;
-            case 3: designed_reg = designed_cpu->reg3_debug; break;
-        }
+        uint8_t designed_reg = packed_register(designed_state, i);
+        uint8_t golden_reg = packed_register(golden_state, i);
 
         std::cout << "    R" << i << ":\t\tDesigned CPU: " << std::setw(3) << (int)designed_reg 
                   << "\tGolden CPU: " << std::setw(3) << (int)golden_reg;
@@ -86,38 +127,93 @@ int main(int argc, char** argv) {
     // Initialize Verilator
     Verilated::commandArgs(argc, argv);
     Verilated::traceEverOn(true);
+
+    uint64_t ring_cycles = 0;
+    std::vector<int> trigger_pcs;
+    std::vector<std::pair<int, int> > trigger_regs;
+    uint64_t window_begin = 0, window_end = 0;
+    std::string store_path;
+    uint64_t checkpoint_every = 0;
+    std::string checkpoint_path, restore_path;
+    uint64_t soak_interval = 0;
+    for (int i = 1; i < argc; i++) {
+        uint64_t value, second;
+        std::string text;
+        std::string arg = argv[i];
+        if (parse_option(arg, "trace-ring", value)) {
+            ring_cycles = value;
+        } else if (parse_option(arg, "trigger-pc", value)) {
+            trigger_pcs.push_back(value);
+        } else if (parse_option(arg, "trigger-reg", value, second)) {
+            trigger_regs.push_back(std::make_pair((int)value, (int)second));
+        } else if (parse_option(arg, "trigger-cycles", value, second)) {
+            window_begin = value;
+            window_end = second;
+        } else if (parse_option(arg, "trace-store", text)) {
+            store_path = text;
+        } else if (parse_option(arg, "cycles", value)) {
+            max_clock_cycles = value;
+        } else if (parse_option(arg, "checkpoint-every", value)) {
+            checkpoint_every = value;
+        } else if (parse_option(arg, "checkpoint", text)) {
+            checkpoint_path = text;
+        } else if (parse_option(arg, "restore", text)) {
+            restore_path = text;
+        } else if (parse_option(arg, "soak", value)) {
+            soak_interval = value;
+        } else if (unknown_option(arg)) {
+            return 1;
+        }
+    }
     
-    // Create hardware CPU and VCD trace
+    // Create hardware CPU and VCD trace (full, or deferred ring with triggers; none for soak
+    // mode, whose bisection re-runs cycles)
     Vmain* designed_cpu = new Vmain;
-    VerilatedVcdC* tfp = new VerilatedVcdC;
-    designed_cpu->trace(tfp, 99);
-    tfp->open("waveform_cpu.vcd");
+    WaveformTrace trace;
+    std::unique_ptr<VerilatedVcdC> tfp;
+    std::unique_ptr<TraceRing<Vmain> > ring;
+    std::unique_ptr<TraceStore<Vmain> > store;
+    if (soak_interval > 0) {
+        // no trace
+    } else if (!store_path.empty()) {
+        store.reset(new TraceStore<Vmain>(*designed_cpu));
+        if (!store->open(store_path)) {
+            return 1;
+        }
+        trace.store = store.get();
+    } else if (ring_cycles > 0) {
+        ring.reset(new TraceRing<Vmain>(*designed_cpu, "waveform_cpu.vcd", ring_cycles));
+        for (int pc : trigger_pcs) {
+            ring->addPcTrigger(pc);
+        }
+        for (const std::pair<int, int>& reg : trigger_regs) {
+            ring->addRegisterTrigger(reg.first, reg.second);
+        }
+        if (window_end > window_begin) {
+            ring->setCycleWindow(window_begin, window_end);
+        }
+        trace.ring = ring.get();
+    } else {
+        tfp.reset(new VerilatedVcdC);
+        designed_cpu->trace(tfp.get(), 99);
+        tfp->open("waveform_cpu.vcd");
+        trace.vcd = tfp.get();
+    }
     
     // Create golden CPU
-    sCPU* golden_cpu = new sCPU;
+    GoldenCPU* golden_cpu = new GoldenCPU;
     
-    // Load instructions into reference CPU (same as in instruction_memory.sv)
-    std::vector<uint8_t> instructions = {
-        0b10001010,  // 0: li r0, 10
-        0b10010000,  // 1: li r1, 0
-        0b10100000,  // 2: li r2, 0
-        0b10110001,  // 3: li r3, 1
-        0b00010111,  // 4: add r1, r1, r3
-        0b00101001,  // 5: add r2, r2, r1
-        0b11010001,  // 6: bner0 r1, 4
-        0b11011111,  // 7: bner0 r3, 7
-        0b00000000,  // 8-15: NOP
-        0b00000000,
-        0b00000000,
-        0b00000000,
-        0b00000000,
-        0b00000000,
-        0b00000000,
-        0b00000000
-    };
+    // Load instructions into reference CPU: the image the RTL ROM holds after its initial
+    // block, i.e. the example program of instruction_memory.sv or the +rom=<file> image
+    designed_cpu->clk = 0;
+    designed_cpu->reset = 0;
+    designed_cpu->eval();
+    std::vector<uint8_t> instructions(16);
+    for (int i = 0; i < 16; i++) {
+        instructions[i] = designed_cpu->rootp->main__DOT__imem_inst__DOT__memory[i];
+    }
     golden_cpu->loadInstructions(instructions);
     
-    uint64_t time = 0;
     bool all_match = true;
     
     std::cout << "Testing Simple ISA CPU (Designed CPU vs Golden CPU)\n";
@@ -125,20 +221,75 @@ int main(int argc, char** argv) {
     
     // Reset both CPUs
     std::cout << "Resetting CPUs...\n";
-    designed_cpu->reset = 1;
-    clock_cycle(designed_cpu, tfp, time);
-    clock_cycle(designed_cpu, tfp, time);
-    designed_cpu->reset = 0;
+    DesignedAdapter designed(*designed_cpu, soak_interval > 0 ? nullptr : &trace);
+    designed.reset();
 
     golden_cpu->setPc(0);
+    GoldenAdapter<GoldenCPU> golden(*golden_cpu);
     std::cout << "ok Reset complete\n\n";
     
-    // Run for clock_cycles clock cycles to execute instructions
-    std::cout << "Running CPUs for " << clock_cycles << " cycles with comparison...\n\n";
-    for (int cycle = 0; cycle < clock_cycles; cycle++) {
+    CpuLockstep lockstep(designed, golden);
+
+    // Continue a checkpointed run: both CPUs (ROM included) and the cycle counter
+    int start_cycle = 0;
+    if (!restore_path.empty()) {
+        Checkpoint restored;
+        if (!read_checkpoint(restore_path, restored)) {
+            return 1;
+        }
+        start_cycle = restore_checkpoint(designed, *golden_cpu, restored);
+        lockstep.restart(start_cycle);
+        instructions.assign(restored.golden_imem, restored.golden_imem + instructions.size());
+        std::cout << "ok Restored " << restore_path << " at cycle " << start_cycle << "\n\n";
+    }
+    Checkpoint checkpoint;
+    bool have_checkpoint = false;
+    bool checkpoint_written = false;
+
+    int clock_cycles = start_cycle;
+    bool halted = false;
+
+    // Soak mode: hash compares every soak_interval cycles, then bisection on a mismatch
+    if (soak_interval > 0) {
+        std::cout << "Soaking CPUs until halt (cap " << max_clock_cycles << " cycles), state hash compared every "
+                  << soak_interval << " cycles...\n\n";
+        typedef VerilatedSnapshots<Vmain, WaveformTrace, GoldenCPU> SoakSnapshots;
+        SoakSnapshots snapshots(designed, *golden_cpu);
+        Soak<DesignedAdapter, GoldenAdapter<GoldenCPU>, SoakSnapshots> soak(designed, golden, snapshots, soak_interval);
+        SoakResult result = soak.run(max_clock_cycles, start_cycle);
+        lockstep.restart(result.cycles);
+        clock_cycles = result.cycles;
+        halted = result.halted;
+
+        if (result.diverged) {
+            std::cout << "  err State hash mismatch, bisected to cycle " << result.first_divergent << " ("
+                      << result.resimulated << " cycles re-simulated)\n";
+            report_mismatch(result.designed_state, result.golden_state, result.first_divergent);
+            print_state(result.designed_state, result.golden_state, result.first_divergent);
+            std::cout << "  err MISMATCH DETECTED!\n\n";
+            all_match = false;
+            if (!checkpoint_path.empty() && write_checkpoint(checkpoint_path, soak.lastGood())) {
+                std::cout << "  Checkpoint of cycle " << soak.lastGood().cycle << " before the mismatch: "
+                          << checkpoint_path << "\n";
+                std::cout << "  ./obj_dir/Vmain --restore=" << checkpoint_path << " --cycles=" << clock_cycles
+                          << "   # trace it\n\n";
+            }
+        } else {
+            std::cout << "ok " << result.compares << " state hash compares matched\n";
+            if (halted) {
+                std::cout << "ok Both CPUs halted after " << clock_cycles << " cycles\n";
+            }
+        }
+    }
+
+    // Run until both CPUs halt (or the cycle cap) to execute instructions
+    if (soak_interval == 0) {
+        std::cout << "Running CPUs until halt (cap " << max_clock_cycles << " cycles) with comparison...\n\n";
+    }
+    for (int cycle = start_cycle; soak_interval == 0 && cycle < max_clock_cycles; cycle++) {
         // First, verify both CPUs are at the same PC before executing
-        uint8_t designed_pc_before = designed_cpu->pc_debug;
-        uint8_t golden_pc_before = golden_cpu->getPc();
+        uint8_t designed_pc_before = packed_pc(lockstep.designedState());
+        uint8_t golden_pc_before = packed_pc(lockstep.goldenState());
         
         if (designed_pc_before != golden_pc_before) {
             std::cout << "  ⚠ Cycle " << std::setw(3) << cycle << ": PC desynchronized before execution - Designed CPU: " 
@@ -146,46 +297,131 @@ int main(int argc, char** argv) {
             all_match = false;
         }
         
-        // Clock the hardware CPU (this executes instruction at current PC and updates PC)
-        clock_cycle(designed_cpu, tfp, time);
-        
-        // Execute the same instruction in reference CPU (after HW clock to sync PC updates)
-        uint8_t written_reg, written_value;
-        bool reg_written = golden_cpu->executeInstruction(written_reg, written_value);
-        
-        // Compare states after each cycle
-        bool match = compare_cpus(designed_cpu, golden_cpu, cycle);
+        // Clock the hardware CPU, then execute the same instruction in the reference CPU,
+        // and compare the packed states (one compare when they match)
+        bool match = lockstep.step();
         if (!match) {
+            report_mismatch(lockstep.designedState(), lockstep.goldenState(), cycle);
             all_match = false;
+            if (have_checkpoint && !checkpoint_path.empty() && !checkpoint_written) {
+                checkpoint_written = write_checkpoint(checkpoint_path, checkpoint);
+                std::cout << "  Checkpoint of cycle " << checkpoint.cycle << " before the mismatch: " << checkpoint_path << "\n";
+            }
+            if (ring) {
+                ring->trigger("mismatch at cycle " + std::to_string(cycle));
+            }
         }
         
         // Print state every 10 cycles, on first cycles, or on mismatch
         if (cycle < 10 || cycle % 10 == 0 || !match) {
-            print_state(designed_cpu, golden_cpu, cycle);
+            print_state(lockstep.designedState(), lockstep.goldenState(), cycle);
             if (!match) {
                 std::cout << "  err MISMATCH DETECTED!\n";
             }
             std::cout << "\n";
         }
+
+        clock_cycles = cycle + 1;
+
+        // Snapshot of the state after clock_cycles cycles
+        if (checkpoint_every > 0 && clock_cycles % checkpoint_every == 0) {
+            save_checkpoint(designed, *golden_cpu, clock_cycles, checkpoint);
+            have_checkpoint = true;
+        }
+
+        // Stop lockstep once both CPUs recognize termination
+        if (lockstep.halted()) {
+            std::cout << "ok Both CPUs halted after " << clock_cycles << " cycles\n";
+            halted = true;
+            break;
+        }
+    }
+    if (!halted && clock_cycles >= max_clock_cycles) {
+        std::cout << "  ⚠ Cycle cap of " << max_clock_cycles << " reached before both CPUs halted\n";
+    }
+    if (have_checkpoint && !checkpoint_path.empty() && !checkpoint_written) {
+        if (write_checkpoint(checkpoint_path, checkpoint)) {
+            std::cout << "Last checkpoint (cycle " << checkpoint.cycle << "): " << checkpoint_path << "\n";
+        }
     }
     
     // Final comparison
     std::cout << "\nFinal State Comparison:\n";
-    print_state(designed_cpu, golden_cpu, clock_cycles);
-    
+    print_state(lockstep.designedState(), lockstep.goldenState(), clock_cycles);
+
+    // Batched golden run must land on the same state as stepping cycle by cycle
+    sCPUMain batched_cpu;
+    batched_cpu.loadInstructions(instructions);
+    sCPUMain::RunResult batched = batched_cpu.run(clock_cycles);
+    bool batched_match = batched.pc == golden_cpu->getPc();
+    for (int i = 0; i < 4; i++) {
+        if (batched.regs[i] != golden_cpu->getRegister(i)) {
+            batched_match = false;
+        }
+    }
+    std::cout << "\nBatched golden run: " << batched.retired << " instructions retired, "
+              << (batched_match ? "ok matches stepped golden CPU" : "err differs from stepped golden CPU") << "\n";
+    if (!batched_match) {
+        all_match = false;
+    }
+
+    // Same for the basic-block translated run
+    sCPUMain block_cpu;
+    block_cpu.loadInstructions(instructions);
+    sCPUMain::RunResult block_run = block_cpu.runBlocks(clock_cycles);
+    bool block_match = block_run.pc == batched.pc && block_run.retired == batched.retired;
+    for (int i = 0; i < 4; i++) {
+        if (block_run.regs[i] != batched.regs[i]) {
+            block_match = false;
+        }
+    }
+    std::cout << "Block-translated golden run: " << block_run.retired << " instructions retired, "
+              << (block_match ? "ok matches batched run" : "err differs from batched run") << "\n";
+    if (!block_match) {
+        all_match = false;
+    }
+
+    // The example program's final state is known at compile time: no golden run needed
+    if (std::equal(instructions.begin(), instructions.end(), EXAMPLE_PROGRAM)) {
+        uint8_t expected_regs[4] = { EXAMPLE_RESULT.regs[0], EXAMPLE_RESULT.regs[1],
+                                     EXAMPLE_RESULT.regs[2], EXAMPLE_RESULT.regs[3] };
+        bool expected_match = lockstep.designedState() == pack_state(EXAMPLE_RESULT.pc, expected_regs);
+        std::cout << "Compile-time expected state: "
+                  << (expected_match ? "ok designed CPU matches" : "err designed CPU differs") << "\n";
+        if (!expected_match) {
+            all_match = false;
+        }
+    }
+
     if (all_match) {
         std::cout << "\nok All comparisons passed! CPUs match perfectly.\n";
     } else {
         std::cout << "\nerr Some mismatches detected. See details above.\n";
     }
     
-    std::cout << "\nVCD file: waveform_cpu.vcd\n";
-    std::cout << "To view waveforms:\n";
-    std::cout << "  gtkwave waveform_cpu.vcd\n";
-    
     // Cleanup
-    tfp->close();
-    delete tfp;
+    if (store) {
+        store->close();
+        std::cout << "\nTrace store: " << store_path << " (" << store->cycleCount() << " cycles)\n";
+        std::cout << "  ./trace_window " << store_path << " <first cycle> <end cycle> window.vcd\n";
+    } else if (ring) {
+        ring->flush();
+        if (ring->written()) {
+            std::cout << "\nVCD file: waveform_cpu.vcd (trigger: " << ring->reason() << ")\n";
+            std::cout << "  gtkwave waveform_cpu.vcd\n";
+        } else {
+            std::cout << "\nNo trace trigger fired, no VCD written\n";
+        }
+    } else if (tfp) {
+        tfp->close();
+        std::cout << "\nVCD file: waveform_cpu.vcd\n";
+        std::cout << "To view waveforms:\n";
+        std::cout << "  gtkwave waveform_cpu.vcd\n";
+    }
+
+    store.reset();
+    ring.reset();
+    tfp.reset();
     delete designed_cpu;
     delete golden_cpu;
     
@@ -8,8 +8,8 @@ verilator --cc \
   register_file.sv \
   alu.sv \
   immediate_extend.sv \
-  --exe main_test.cpp sCPU.cpp \
-  --trace
+  --exe main_test.cpp sCPU.cpp trace_store.cpp checkpoint.cpp \
+  --trace --savable
 
 make -C obj_dir -f Vmain.mk
 
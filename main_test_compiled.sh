@@ -0,0 +1,21 @@
+# Co-simulation against the ahead-of-time compiled golden model
+g++ -O2 -std=c++17 scpu_compile.cpp rom_image.cpp sCPU.cpp -o scpu_compile
+./scpu_compile binary_data.txt sCPUCompiled.cpp
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe main_test.cpp sCPU.cpp trace_store.cpp checkpoint.cpp sCPUCompiled.cpp \
+  --trace --savable \
+  -CFLAGS "-O2 -DSCPU_COMPILED"
+
+make -C obj_dir -f Vmain.mk
+
+./obj_dir/Vmain
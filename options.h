@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Command line options of the drivers: --name=value and plain --flag arguments.
+// Numbers are decimal, or hexadecimal with a 0x prefix; a malformed number exits with an
+// error. Each driver checks its options in turn and ends with unknown_option(), so a
+// mistyped option is reported instead of silently ignored.
+
+// True if arg is --name=<number>, value set
+inline bool parse_option(const std::string& arg, const std::string& name, uint64_t& value) {
+    std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::string text = arg.substr(prefix.size());
+    bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+    char* end = nullptr;
+    value = std::strtoull(text.c_str(), &end, hex ? 16 : 10);
+    if (text.empty() || text[0] == '-' || *end != '\0') {
+        std::cerr << "err --" << name << " expects a number, got '" << text << "'\n";
+        std::exit(1);
+    }
+    return true;
+}
+
+// True if arg is --name=<number>:<number> (e.g. register:value, first:end), both set
+inline bool parse_option(const std::string& arg, const std::string& name, uint64_t& first, uint64_t& second) {
+    std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    size_t colon = arg.find(':', prefix.size());
+    if (colon == std::string::npos) {
+        std::cerr << "err --" << name << " expects <number>:<number>, got '" << arg.substr(prefix.size()) << "'\n";
+        std::exit(1);
+    }
+    parse_option(arg.substr(0, colon), name, first);
+    parse_option(prefix + arg.substr(colon + 1), name, second);
+    return true;
+}
+
+// True if arg is --name=<text>, value set
+inline bool parse_option(const std::string& arg, const std::string& name, std::string& value) {
+    std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+// True (after printing an error) if arg looks like an option but none of the driver's
+// options matched it; Verilator's +plusargs and positional arguments pass
+inline bool unknown_option(const std::string& arg) {
+    if (arg.compare(0, 2, "--") != 0) {
+        return false;
+    }
+    std::cerr << "err unknown option " << arg << "\n";
+    return true;
+}
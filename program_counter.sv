@@ -1,19 +1,25 @@
-module program_counter(
+module program_counter #(
+    parameter PC_WIDTH = 4  // ROM of 2**PC_WIDTH instructions; PC wraps to 0 after the last one
+)(
     input logic clk,
     input logic [1:0] opcode,
-    input logic [3:0] set_value,
+    input logic [PC_WIDTH-1:0] set_value,
     input logic reset,
-    output logic [3:0] pc_out
+    output logic [PC_WIDTH-1:0] pc_out
 );
 
+// PC register, public so harnesses can preset it (sweep_rtl)
+logic [PC_WIDTH-1:0] pc /* verilator public_flat_rw */;
+assign pc_out = pc;
+
 always_ff @(posedge clk) begin
 
     if (reset) begin
-        pc_out <= 4'b0000; // Reset PC to 0
+        pc <= '0; // Reset PC to 0
     end else if (opcode == 2'b11) begin
-        pc_out <= set_value; // Branch instruction sets PC to address
+        pc <= set_value; // Branch instruction sets PC to address
     end else begin
-        pc_out <= pc_out + 4'b0001; // Increment PC by 1
+        pc <= pc + 1'b1; // Increment PC by 1
     end
 
 end
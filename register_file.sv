@@ -1,23 +1,29 @@
 
-module register_file(
+module register_file #(
+    parameter REGISTERS = 4,  // power of two, at least 4 (R0..R3 have debug outputs)
+    parameter DATA_WIDTH = 8,
+    localparam REG_BITS = $clog2(REGISTERS)
+)(
     input logic clk,
+    input logic reset, // clears all registers, so programs can run back to back
     input logic we, // write enable
-    input logic [1:0] rd, // destination register
-    input logic [1:0] rs1, // source register 1
-    input logic [1:0] rs2, // source register 2
-    input logic [7:0] wd, // write data
-    output logic [7:0] rd_out, // read data from rd
-    output logic [7:0] rs1_out, // read data from rs1
-    output logic [7:0] rs2_out, // read data from rs2
-    // Debug outputs for all registers
-    output logic [7:0] reg0_out,
-    output logic [7:0] reg1_out,
-    output logic [7:0] reg2_out,
-    output logic [7:0] reg3_out
+    input logic [REG_BITS-1:0] rd, // destination register
+    input logic [REG_BITS-1:0] rs1, // source register 1
+    input logic [REG_BITS-1:0] rs2, // source register 2
+    input logic [DATA_WIDTH-1:0] wd, // write data
+    output logic [DATA_WIDTH-1:0] rd_out, // read data from rd
+    output logic [DATA_WIDTH-1:0] rs1_out, // read data from rs1
+    output logic [DATA_WIDTH-1:0] rs2_out, // read data from rs2
+    // Debug outputs for the first four registers
+    output logic [DATA_WIDTH-1:0] reg0_out,
+    output logic [DATA_WIDTH-1:0] reg1_out,
+    output logic [DATA_WIDTH-1:0] reg2_out,
+    output logic [DATA_WIDTH-1:0] reg3_out
 );
 
-    // Define 4 registers of 8 bits each (2 bits to address 4 registers)
-    logic [7:0] registers [0:3];
+    // REGISTERS registers of DATA_WIDTH bits (default: 4 registers of 8 bits, 2 bits to address them)
+    // Public so harnesses can preset the register file (sweep_rtl)
+    logic [DATA_WIDTH-1:0] registers [0:REGISTERS-1] /* verilator public_flat_rw */;
 
     // Read ports (combinational)
     assign rs1_out = registers[rs1];
@@ -32,7 +38,11 @@ module register_file(
 
     // Write port (sequential)
     always_ff @(posedge clk) begin
-        if (we) begin
+        if (reset) begin
+            for (int i = 0; i < REGISTERS; i++) begin
+                registers[i] <= '0;
+            end
+        end else if (we) begin
             registers[rd] <= wd; // Write data to destination register
         end
     end
@@ -38,6 +38,7 @@ int main(int argc, char** argv) {
     std::cout << "=====================\n\n";
     
     // Initialize
+    rf->reset = 0;
     rf->we = 0;
     rf->rd = 0;
     rf->rs1 = 0;
@@ -232,6 +233,24 @@ int main(int argc, char** argv) {
         return 1;
     }
     std::cout << "  ✓ All three ports read correctly\n\n";
+
+    // Test 9: Reset clears every register, even with a write pending
+    std::cout << "Test 9: Reset clears all registers\n";
+    rf->reset = 1;
+    rf->we = 1;
+    rf->rd = 1;
+    rf->wd = 0x5A;
+    clock_cycle(rf, tfp, time);
+    rf->reset = 0;
+    rf->we = 0;
+    rf->eval();
+    tfp->dump(time++);
+
+    if (rf->reg0_out != 0 || rf->reg1_out != 0 || rf->reg2_out != 0 || rf->reg3_out != 0) {
+        std::cerr << "  ✗ FAIL: Registers not cleared by reset\n";
+        return 1;
+    }
+    std::cout << "  ✓ r0..r3 = 0 after reset\n\n";
     
     // Cleanup
     tfp->close();
@@ -0,0 +1,19 @@
+# Verilate and compile once ...
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe rom_batch_test.cpp campaign.cpp corpus.cpp rom_image.cpp sCPU.cpp \
+  --trace \
+  -CFLAGS "-O2"
+
+make -C obj_dir -f Vmain.mk -j
+
+# ... then run any number of programs back to back
+./obj_dir/Vmain binary_data.txt --random=10000
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "rom_image.h"
+
+// Read a program in the text format
+bool read_text_program(const std::string& path, std::vector<uint8_t>& program) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        line = line.substr(0, std::min(line.find('#'), line.find("//")));
+
+        std::string word;
+        std::istringstream fields(line);
+        if (!(fields >> word)) {
+            continue;
+        }
+        if (word.size() != 8 || word.find_first_not_of("01") != std::string::npos) {
+            std::cerr << "err " << path << ":" << line_number << ": expected 8 binary digits, got '" << word << "'\n";
+            return false;
+        }
+        program.push_back(static_cast<uint8_t>(std::stoi(word, nullptr, 2)));
+    }
+    return true;
+}
+
+// Read a program as raw bytes
+bool read_raw_program(const std::string& path, std::vector<uint8_t>& program) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+    program.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Write a program in the text format ('//' comments, so $readmemb accepts it)
+bool write_text_program(const std::string& path, const std::vector<uint8_t>& program) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "err Cannot write " << path << "\n";
+        return false;
+    }
+    for (size_t i = 0; i < program.size(); i++) {
+        for (int bit = 7; bit >= 0; bit--) {
+            out << (((program[i] >> bit) & 1) ? '1' : '0');
+        }
+        out << "    // " << i << "\n";
+    }
+    return (bool)out;
+}
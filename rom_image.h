@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ROM image files shared by the RTL and the golden model.
+// Text format (binary_data.txt): one 8-bit binary word per line, '//' or '#' comments.
+// With '//' comments only, the same file loads into instruction_memory.sv through
+// $readmemb (+rom=<file>) and into sCPU::loadInstructions through read_text_program.
+
+// Read a program in the text format
+bool read_text_program(const std::string& path, std::vector<uint8_t>& program);
+
+// Read a program as raw bytes
+bool read_raw_program(const std::string& path, std::vector<uint8_t>& program);
+
+// Write a program in the text format ('//' comments, so $readmemb accepts it)
+bool write_text_program(const std::string& path, const std::vector<uint8_t>& program);
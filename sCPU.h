@@ -1,43 +1,739 @@
+#pragma once
+
+#include <cstddef>
 #include <cstdint>
+#include <ostream>
+#include <type_traits>
 #include <vector>
 
-class sCPU {
+// Instruction format (sISA, 8-bit in the default configuration):
+// Bits 7-6: opcode (2 bits)
+// LOAD (10): 10 DD MMMM (dest=2bits, immediate=4bits)
+// ADD  (00): 00 DD S1 S2 (dest=2bits, src1=2bits, src2=2bit)
+// JUMP (11): 11 AAAA S2 (address=4bits, src2=2bit)
+// BNER0 (11): 11 AAAA S2 (branch to address if register S2 != r0)
+
+// Size-independent part of the golden model
+class sCPUBase {
     public:
-        sCPU();
-        ~sCPU();
+        // Micro-op kinds, numerically equal to the 2-bit opcode they come from
+        enum OpKind : uint8_t {
+            OP_ADD   = 0b00,
+            OP_NOP   = 0b01,
+            OP_LOAD  = 0b10,
+            OP_BNER0 = 0b11
+        };
 
-        // Get/Set PC
-        uint8_t getPc();
-        void setPc(uint8_t pc);
+        // Why a batched run stopped
+        enum StopReason : uint8_t {
+            STOP_LIMIT,       // max_instructions retired
+            STOP_BREAKPOINT,  // PC reached stop_pc (instruction there not executed)
+            STOP_HALT         // taken branch-to-self: state can no longer change
+        };
 
+        // Longest straight-line run translated into a single block
+        static constexpr int MAX_BLOCK_LENGTH = 32;
 
-        // This section was made private, because these methods are only used in construction and execution internally.
-        // They are not intended to be called directly from outside the class.
+        // Execution profile policy for run / runUntil / executeInstruction, selected at
+        // compile time: the hooks of NoProfile are empty, so the default build is the
+        // uninstrumented loop. Block execution (runBlocks) is never profiled.
+        struct NoProfile {
+            constexpr void retire(uint32_t, uint8_t) {}
+            constexpr void branch(uint32_t, bool) {}
+            constexpr void write(uint32_t) {}
+        };
 
-        // Get/Set register values
-        uint8_t getRegister(uint8_t register_index);
-        void setRegister(uint8_t register_index, uint8_t register_value);
+        static constexpr int log2(int value) {
+            return value <= 1 ? 0 : 1 + log2(value / 2);
+        }
+
+        // Default operand field: room for the branch target or for rs1 and rs2
+        static constexpr int fieldBits(int pc_bits, int registers) {
+            return pc_bits > 2 * log2(registers) ? pc_bits : 2 * log2(registers);
+        }
+};
+
+// Golden model sized at compile time, matching the parameters of main.sv:
+//   PC_BITS      program_counter PC_WIDTH (ROM of 2^PC_BITS instructions, PC wraps to 0)
+//   REGISTERS    register_file REGISTERS (power of two, at least 4)
+//   DATA_BITS    register / ALU DATA_WIDTH (results wrap modulo 2^DATA_BITS)
+//   FIELD_WIDTH  operand field (default max(PC_BITS, 2 * REGISTER_BITS))
+//
+// Instructions keep the sISA layout with wider fields: 2-bit opcode, REGISTER_BITS for rd,
+// then FIELD_BITS holding rs1/rs2 (ADD), the immediate (LOAD) or the branch target above
+// rs2 (BNER0):
+//   ADD    00 | rd | pad | rs1 | rs2
+//   LOAD   10 | rd | imm
+//   BNER0  11 | addr | rs2
+// sCPUSized<4, 4, 8> (sCPUMain) is the default main.sv: 8-bit instructions, 16-entry ROM.
+// sCPU is the same encoding with an 8-bit PC: branch targets 0..15, then slots 16..255 read
+// 0x00 (add r0, r0, r0) until the PC wraps.
+//
+// Storage is fixed-size and the PC is masked to PC_BITS, so every loop indexes the decoded
+// ROM without bounds checks. Every size gets the same execution modes: single steps, the
+// threaded run loop (optionally profiled), basic-block translation with cycle fast-forward.
+template <int PC_BITS, int REGISTERS, int DATA_BITS, int FIELD_WIDTH = sCPUBase::fieldBits(PC_BITS, REGISTERS)>
+class sCPUSized : public sCPUBase {
+    static_assert(PC_BITS >= 1 && PC_BITS <= 16, "PC_BITS must be 1..16");
+    static_assert(REGISTERS >= 4 && REGISTERS <= 256 && (REGISTERS & (REGISTERS - 1)) == 0,
+                  "REGISTERS must be a power of two, 4..256");
+    static_assert(DATA_BITS >= 1 && DATA_BITS <= 32, "DATA_BITS must be 1..32");
+    static_assert(FIELD_WIDTH >= 2 * log2(REGISTERS) && FIELD_WIDTH <= 24, "FIELD_WIDTH must hold rs1 and rs2");
+
+    // Smallest unsigned type of at least bits bits
+    template <int bits>
+    using Uint = typename std::conditional<(bits <= 8), uint8_t,
+                 typename std::conditional<(bits <= 16), uint16_t, uint32_t>::type>::type;
+
+    public:
+        // Template parameters, for code generic over the configuration
+        static constexpr int PC_WIDTH = PC_BITS;
+        static constexpr int REGISTER_COUNT = REGISTERS;
+        static constexpr int DATA_WIDTH = DATA_BITS;
+
+        static constexpr int REGISTER_BITS = log2(REGISTERS);
+        static constexpr int FIELD_BITS = FIELD_WIDTH;
+        static constexpr int INSTRUCTION_BITS = 2 + REGISTER_BITS + FIELD_BITS;
+        static constexpr uint32_t ROM_SIZE = 1u << PC_BITS;
+
+        typedef Uint<PC_BITS> Pc;
+        typedef Uint<REGISTER_BITS> Register;
+        typedef Uint<DATA_BITS> Data;
+        typedef Uint<INSTRUCTION_BITS> Word;
+
+        static constexpr uint32_t PC_MASK = ROM_SIZE - 1;
+        static constexpr uint32_t DATA_MASK = (uint32_t)((1ull << DATA_BITS) - 1);
+
+        // Pre-decoded instruction: every field already extracted from the encoding
+        struct MicroOp {
+            uint8_t kind;       // OpKind
+            Register rd;        // destination register (ADD, LOAD)
+            Register rs1;       // source register 1 (ADD)
+            Register rs2;       // source register 2 (ADD, BNER0)
+            Data imm;           // LOAD immediate, truncated to DATA_BITS
+            Pc target;          // BNER0 target, truncated to PC_BITS
+        };
+
+        // Summary of a batched run
+        struct RunResult {
+            uint64_t retired;           // instructions retired during this call
+            Pc pc;                      // final PC
+            Data regs[REGISTERS];       // final registers
+            StopReason stop_reason;
+        };
+
+        // Translated basic block: straight-line LOAD/ADD/NOP run, optionally ending in a BNER0.
+        // The straight-line part is folded into one affine update of the register file:
+        // regs[k] = constant[k] + sum_j coef[k][j] * regs[j] (mod 2^DATA_BITS), for every k in write_mask.
+        struct Block {
+            uint8_t length;             // instructions in the block, including the branch (0: not translated)
+            bool ends_in_branch;
+            Register branch_rs2;        // BNER0 source register
+            Pc branch_target;           // BNER0 target address
+            uint32_t write_mask;        // bit k set if register k is updated
+            Data constant[REGISTERS];
+            Data coef[REGISTERS][REGISTERS];
+        };
+
+        // Counters of a profiled run; plain arrays, exported in bulk by writeCsv()
+        struct Profile {
+            uint64_t opcode[4];                     // retired instructions per OpKind
+            uint64_t pc_hits[ROM_SIZE];             // retired instructions per PC
+            uint64_t branch_taken[ROM_SIZE];        // per BNER0 site
+            uint64_t branch_not_taken[ROM_SIZE];
+            uint64_t register_writes[REGISTERS];
+
+            Profile() { clear(); }
 
-        // Load program as raw instruction bytes (8-bit instructions)
-        void loadInstructions(const std::vector<uint8_t>& bytes);
+            void retire(uint32_t pc, uint8_t kind) {
+                this->opcode[kind]++;
+                this->pc_hits[pc]++;
+            }
+            void branch(uint32_t pc, bool taken) {
+                (taken ? this->branch_taken : this->branch_not_taken)[pc]++;
+            }
+            void write(uint32_t rd) {
+                this->register_writes[rd]++;
+            }
 
-        // Helper: fetch 8-bit instruction at given address
-        uint8_t fetchInstruction(uint8_t index);
+            void clear() {
+                for (int i = 0; i < 4; ++i) {
+                    this->opcode[i] = 0;
+                }
+                for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                    this->pc_hits[i] = 0;
+                    this->branch_taken[i] = 0;
+                    this->branch_not_taken[i] = 0;
+                }
+                for (int i = 0; i < REGISTERS; ++i) {
+                    this->register_writes[i] = 0;
+                }
+            }
 
+            uint64_t retired() const {
+                return this->opcode[0] + this->opcode[1] + this->opcode[2] + this->opcode[3];
+            }
+
+            // Accumulate another profile (e.g. one per worker thread)
+            void add(const Profile& other) {
+                for (int i = 0; i < 4; ++i) {
+                    this->opcode[i] += other.opcode[i];
+                }
+                for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                    this->pc_hits[i] += other.pc_hits[i];
+                    this->branch_taken[i] += other.branch_taken[i];
+                    this->branch_not_taken[i] += other.branch_not_taken[i];
+                }
+                for (int i = 0; i < REGISTERS; ++i) {
+                    this->register_writes[i] += other.register_writes[i];
+                }
+            }
+
+            // Non-zero counters as CSV lines "counter,index,count"
+            void writeCsv(std::ostream& out) const {
+                static const char* const opcode_names[4] = { "add", "nop", "load", "bner0" };
+                out << "counter,index,count\n";
+                for (int i = 0; i < 4; ++i) {
+                    if (this->opcode[i] != 0) {
+                        out << "opcode," << opcode_names[i] << "," << this->opcode[i] << "\n";
+                    }
+                }
+                for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                    if (this->pc_hits[i] != 0) {
+                        out << "pc," << i << "," << this->pc_hits[i] << "\n";
+                    }
+                }
+                for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                    if (this->branch_taken[i] != 0) {
+                        out << "branch_taken," << i << "," << this->branch_taken[i] << "\n";
+                    }
+                    if (this->branch_not_taken[i] != 0) {
+                        out << "branch_not_taken," << i << "," << this->branch_not_taken[i] << "\n";
+                    }
+                }
+                for (int i = 0; i < REGISTERS; ++i) {
+                    if (this->register_writes[i] != 0) {
+                        out << "register_write,r" << i << "," << this->register_writes[i] << "\n";
+                    }
+                }
+            }
+        };
+
+        // Split an encoding into its fields: 8-bit encodings (FIELD_WIDTH 4) are served from a
+        // 256-entry table built at compile time, wider ones are sliced on the fly
+        static constexpr MicroOp decode(Word instruction) {
+            if constexpr (INSTRUCTION_BITS == 8) {
+                return DECODE_TABLE.ops[instruction];
+            } else {
+                return decodeFields(instruction);
+            }
+        }
+
+        // Decode table covering every 8-bit encoding
+        struct DecodeTable {
+            MicroOp ops[256];
+
+            constexpr DecodeTable() : ops{} {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    this->ops[i] = decodeFields((Word)i);
+                }
+            }
+        };
+
+        // Field slicing behind decode (and its table)
+        static constexpr MicroOp decodeFields(Word instruction) {
+            const uint32_t field_mask = (1u << FIELD_BITS) - 1;
+            const uint32_t register_mask = REGISTERS - 1;
+            MicroOp op = {};
+            op.kind = (instruction >> (INSTRUCTION_BITS - 2)) & 0x3;
+            if (op.kind == OP_LOAD) {
+                op.rd = (instruction >> FIELD_BITS) & register_mask;
+                op.imm = (instruction & field_mask) & DATA_MASK;
+            } else if (op.kind == OP_ADD) {
+                op.rd = (instruction >> FIELD_BITS) & register_mask;
+                op.rs1 = (instruction >> REGISTER_BITS) & register_mask;
+                op.rs2 = instruction & register_mask;
+            } else if (op.kind == OP_BNER0) {
+                op.target = (instruction >> REGISTER_BITS) & field_mask & PC_MASK;
+                op.rs2 = instruction & register_mask;
+            }
+            return op;
+        }
+
+        // Only instantiated (by decode) for 8-bit encodings
+        static constexpr DecodeTable DECODE_TABLE = DecodeTable();
+
+        // Encodings, e.g. to build programs for the wider configurations
+        static constexpr Word encodeAdd(uint32_t rd, uint32_t rs1, uint32_t rs2) {
+            return (Word)(((uint32_t)OP_ADD << (INSTRUCTION_BITS - 2)) | (rd << FIELD_BITS)
+                          | (rs1 << REGISTER_BITS) | rs2);
+        }
+        static constexpr Word encodeLoad(uint32_t rd, uint32_t imm) {
+            return (Word)(((uint32_t)OP_LOAD << (INSTRUCTION_BITS - 2)) | (rd << FIELD_BITS)
+                          | (imm & ((1u << FIELD_BITS) - 1)));
+        }
+        static constexpr Word encodeBner0(uint32_t rs2, uint32_t target) {
+            return (Word)(((uint32_t)OP_BNER0 << (INSTRUCTION_BITS - 2))
+                          | ((target & ((1u << FIELD_BITS) - 1)) << REGISTER_BITS) | rs2);
+        }
+
+        // One instruction on explicit state; the instruction semantics shared by
+        // executeInstruction and sCPUConstexpr. Returns true if register written_reg was written.
+        template <typename ProfilePolicy>
+        static constexpr bool execute(const MicroOp& op, Pc& pc, Data* regs, Register& written_reg,
+                                      Data& written_value, ProfilePolicy& profile) {
+            profile.retire(pc, op.kind);
+            switch (op.kind) {
+                case OP_LOAD:
+                    // LOAD: rd = imm
+                    regs[op.rd] = op.imm;
+                    written_reg = op.rd;
+                    written_value = op.imm;
+                    profile.write(op.rd);
+                    pc = (pc + 1) & PC_MASK;
+                    return true;
+
+                case OP_ADD:
+                    // ADD: rd = rs1 + rs2
+                    regs[op.rd] = (regs[op.rs1] + regs[op.rs2]) & DATA_MASK;
+                    written_reg = op.rd;
+                    written_value = regs[op.rd];
+                    profile.write(op.rd);
+                    pc = (pc + 1) & PC_MASK;
+                    return true;
+
+                case OP_BNER0:
+                    // Branch to address if register S2 != r0
+                    if (regs[op.rs2] != regs[0]) {
+                        profile.branch(pc, true);
+                        pc = op.target;
+                    } else {
+                        profile.branch(pc, false);
+                        pc = (pc + 1) & PC_MASK;
+                    }
+                    return false;
+
+                default:
+                    pc = (pc + 1) & PC_MASK;
+                    return false;
+            }
+        }
+
+        // True if op at pc is a taken branch to itself: the state can no longer change
+        static constexpr bool haltsAt(const MicroOp& op, uint32_t pc, const Data* regs) {
+            return op.kind == OP_BNER0 && op.target == pc && regs[op.rs2] != regs[0];
+        }
+
+        sCPUSized() {
+            this->pc_ = 0;
+            for (int i = 0; i < REGISTERS; ++i) {
+                this->regs_[i] = 0;
+            }
+            const MicroOp nop = decode(0);
+            for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                this->imem_[i] = 0;
+                this->uops_[i] = nop;
+            }
+            this->fast_forward_ = false;
+        }
+
+        // Get/Set PC
+        Pc getPc() const { return this->pc_; }
+        void setPc(uint32_t pc) { this->pc_ = pc & PC_MASK; }
+
+        // R0..R3 and the low 8 PC bits in the layout of main.sv's state_debug
+        uint64_t getPackedState() const {
+            static_assert(8 + 4 * DATA_BITS <= 64, "packed state holds R0..R3 in 64 bits");
+            uint64_t state = this->pc_ & 0xFF;
+            for (int i = 0; i < 4; ++i) {
+                state |= (uint64_t)this->regs_[i] << (8 + i * DATA_BITS);
+            }
+            return state;
+        }
+
+        // Get/Set register values
+        Data getRegister(uint32_t register_index) const {
+            return register_index < (uint32_t)REGISTERS ? this->regs_[register_index] : 0;
+        }
+        void setRegister(uint32_t register_index, uint32_t register_value) {
+            if (register_index < (uint32_t)REGISTERS) {
+                this->regs_[register_index] = register_value & DATA_MASK;
+            }
+        }
+
+        // Load program words (at most ROM_SIZE; the rest of the ROM reads 0), decoded once so
+        // the step loops only dispatch
+        template <typename T>
+        void loadInstructions(const T* words, size_t size) {
+            for (uint32_t i = 0; i < ROM_SIZE; ++i) {
+                this->imem_[i] = i < size ? (Word)words[i] : 0;
+                this->uops_[i] = decode(this->imem_[i]);
+            }
+            this->blocks_.clear();
+        }
+        void loadInstructions(const std::vector<Word>& words) {
+            loadInstructions(words.data(), words.size());
+        }
+        template <typename T>
+        void loadInstructions(const std::vector<T>& words) {
+            loadInstructions(words.data(), words.size());
+        }
+
+        // Helper: fetch instruction at given address
+        Word fetchInstruction(uint32_t index) const {
+            return this->imem_[index & PC_MASK];
+        }
 
         // Execute one instruction at PC
         // Returns true if a register was written
         // Also RETURNS which register and value were written via reference parameters
-        bool executeInstruction(uint8_t& written_reg, uint8_t& written_value);
+        template <typename RegisterOut, typename DataOut>
+        bool executeInstruction(RegisterOut& written_reg, DataOut& written_value) {
+            NoProfile profile;
+            return executeInstruction(written_reg, written_value, profile);
+        }
+
+        // Same, reporting to a profile policy (NoProfile, Profile or any type with the same hooks)
+        template <typename RegisterOut, typename DataOut, typename ProfilePolicy>
+        bool executeInstruction(RegisterOut& written_reg, DataOut& written_value, ProfilePolicy& profile) {
+            Register reg = 0;
+            Data value = 0;
+            if (!execute(this->uops_[this->pc_], this->pc_, this->regs_, reg, value, profile)) {
+                return false;
+            }
+            written_reg = reg;
+            written_value = value;
+            return true;
+        }
+
+        // True when the program has finished: the instruction at PC is a taken branch to
+        // itself, so the state can no longer change. Slots past the program hold 0x00
+        // (add r0, r0, r0), which still executes; the PC wraps at ROM_SIZE.
+        bool isHalted() const {
+            return haltsAt(this->uops_[this->pc_], this->pc_, this->regs_);
+        }
+
+        // Execute up to max_instructions in one tight loop (no per-step out-parameters)
+        RunResult run(uint64_t max_instructions) {
+            NoProfile profile;
+            return runLoop(max_instructions, ROM_SIZE, profile);
+        }
+
+        // Same as run, but also stops before executing the instruction at stop_pc
+        // (stop_pc >= ROM_SIZE is never reached)
+        RunResult runUntil(uint64_t max_instructions, uint32_t stop_pc) {
+            NoProfile profile;
+            return runLoop(max_instructions, stop_pc, profile);
+        }
+
+        // Same as run / runUntil, reporting to a profile policy
+        template <typename ProfilePolicy>
+        RunResult run(uint64_t max_instructions, ProfilePolicy& profile) {
+            return runLoop(max_instructions, ROM_SIZE, profile);
+        }
+        template <typename ProfilePolicy>
+        RunResult runUntil(uint64_t max_instructions, uint32_t stop_pc, ProfilePolicy& profile) {
+            return runLoop(max_instructions, stop_pc, profile);
+        }
+
+        // Same as run, but executes whole translated basic blocks (translated on first use)
+        RunResult runBlocks(uint64_t max_instructions) {
+            static_assert(REGISTERS <= 16, "block translation keeps a REGISTERS x REGISTERS matrix per block");
+            if (this->blocks_.empty()) {
+                this->blocks_.assign(ROM_SIZE, Block());
+            }
+            const Block* blocks = this->blocks_.data();
+            Pc pc = this->pc_;
+            Data regs[REGISTERS];
+            for (int i = 0; i < REGISTERS; ++i) {
+                regs[i] = this->regs_[i];
+            }
+            uint64_t retired = 0;
+            StopReason stop_reason = STOP_LIMIT;
+
+            // Cycle detection (Brent): equal states at two block boundaries mean execution
+            // repeats with that period from here on
+            bool detect_cycle = this->fast_forward_;
+            bool saved = false;
+            Pc saved_pc = 0;
+            Data saved_regs[REGISTERS] = {};
+            uint64_t saved_retired = 0;
+            uint64_t blocks_since_save = 0;
+            uint64_t save_interval = 1;
+
+            while (retired < max_instructions) {
+                if (detect_cycle) {
+                    bool repeated = saved && pc == saved_pc;
+                    for (int i = 0; repeated && i < REGISTERS; ++i) {
+                        repeated = regs[i] == saved_regs[i];
+                    }
+                    if (repeated) {
+                        // Skip every full period that still fits in the budget; the rest is executed
+                        uint64_t period = retired - saved_retired;
+                        retired += (max_instructions - retired) / period * period;
+                        detect_cycle = false;
+                        continue;
+                    }
+                    if (blocks_since_save == save_interval || !saved) {
+                        saved = true;
+                        saved_pc = pc;
+                        for (int i = 0; i < REGISTERS; ++i) {
+                            saved_regs[i] = regs[i];
+                        }
+                        saved_retired = retired;
+                        save_interval *= 2;
+                        blocks_since_save = 0;
+                    }
+                    blocks_since_save++;
+                }
+
+                if (this->blocks_[pc].length == 0) {
+                    translateBlock(pc);
+                }
+                const Block& block = blocks[pc];
+
+                if (block.length > max_instructions - retired) {
+                    // Not enough budget for the whole block: finish instruction by instruction.
+                    // The branch is the last instruction, so only straight-line ops remain here.
+                    while (retired < max_instructions) {
+                        const MicroOp& op = this->uops_[pc];
+                        if (op.kind == OP_LOAD) {
+                            regs[op.rd] = op.imm;
+                        } else if (op.kind == OP_ADD) {
+                            regs[op.rd] = (regs[op.rs1] + regs[op.rs2]) & DATA_MASK;
+                        }
+                        pc = (pc + 1) & PC_MASK;
+                        retired++;
+                    }
+                    break;
+                }
+
+                // One fused register file update for the whole straight-line part
+                if (block.write_mask != 0) {
+                    Data old_regs[REGISTERS];
+                    for (int j = 0; j < REGISTERS; ++j) {
+                        old_regs[j] = regs[j];
+                    }
+                    for (int k = 0; k < REGISTERS; ++k) {
+                        if (block.write_mask & (1u << k)) {
+                            uint32_t value = block.constant[k];
+                            for (int j = 0; j < REGISTERS; ++j) {
+                                value += (uint32_t)block.coef[k][j] * old_regs[j];
+                            }
+                            regs[k] = value & DATA_MASK;
+                        }
+                    }
+                }
+                retired += block.length;
+
+                // Branch evaluated once per block
+                Pc branch_pc = (pc + block.length - 1) & PC_MASK;
+                if (block.ends_in_branch && regs[block.branch_rs2] != regs[0]) {
+                    if (block.branch_target == branch_pc) {
+                        pc = branch_pc;
+                        stop_reason = STOP_HALT;
+                        break;
+                    }
+                    pc = block.branch_target;
+                } else {
+                    pc = (branch_pc + 1) & PC_MASK;
+                }
+            }
+
+            return finish(pc, regs, retired, stop_reason);
+        }
+
+        // Cycle fast-forward for runBlocks (off by default): once the state at a block
+        // boundary repeats, whole periods are skipped in O(1) with exact retired counts
+        void setFastForward(bool enabled) {
+            this->fast_forward_ = enabled;
+        }
 
     private:
+        // Shared loop behind run/runUntil; stop_pc >= ROM_SIZE means no breakpoint
+        template <typename ProfilePolicy>
+        RunResult runLoop(uint64_t max_instructions, uint32_t stop_pc, ProfilePolicy& profile) {
+            // Work on local copies so the compiler can keep the state in registers
+            Pc pc = this->pc_;
+            Data regs[REGISTERS];
+            for (int i = 0; i < REGISTERS; ++i) {
+                regs[i] = this->regs_[i];
+            }
+            const MicroOp* uops = this->uops_;
+            const MicroOp* op;
+            uint64_t retired = 0;
+            StopReason stop_reason;
+
+#if defined(__GNUC__)
+            // Threaded dispatch: each handler jumps straight to the next one (computed goto)
+            static void* const handlers[4] = { &&op_add, &&op_nop, &&op_load, &&op_bner0 };
+            #define SCPU_DISPATCH()                                          \
+                do {                                                         \
+                    if (retired == max_instructions) goto stop_limit;        \
+                    if (pc == stop_pc) goto stop_breakpoint;                 \
+                    op = &uops[pc];                                          \
+                    goto *handlers[op->kind];                                \
+                } while (0)
+
+            SCPU_DISPATCH();
+
+        op_add:
+            profile.retire(pc, OP_ADD);
+            profile.write(op->rd);
+            regs[op->rd] = (regs[op->rs1] + regs[op->rs2]) & DATA_MASK;
+            pc = (pc + 1) & PC_MASK;
+            retired++;
+            SCPU_DISPATCH();
+
+        op_nop:
+            profile.retire(pc, OP_NOP);
+            pc = (pc + 1) & PC_MASK;
+            retired++;
+            SCPU_DISPATCH();
+
+        op_load:
+            profile.retire(pc, OP_LOAD);
+            profile.write(op->rd);
+            regs[op->rd] = op->imm;
+            pc = (pc + 1) & PC_MASK;
+            retired++;
+            SCPU_DISPATCH();
+
+        op_bner0:
+            profile.retire(pc, OP_BNER0);
+            retired++;
+            if (regs[op->rs2] != regs[0]) {
+                profile.branch(pc, true);
+                if (op->target == pc) {
+                    goto stop_halt;
+                }
+                pc = op->target;
+            } else {
+                profile.branch(pc, false);
+                pc = (pc + 1) & PC_MASK;
+            }
+            SCPU_DISPATCH();
+
+            #undef SCPU_DISPATCH
+#else
+            // Portable fallback: the shared instruction semantics, one switch per step
+            for (;;) {
+                if (retired == max_instructions) goto stop_limit;
+                if (pc == stop_pc) goto stop_breakpoint;
+                op = &uops[pc];
+                retired++;
+                if (haltsAt(*op, pc, regs)) {
+                    profile.retire(pc, OP_BNER0);
+                    profile.branch(pc, true);
+                    goto stop_halt;
+                }
+                Register written_reg = 0;
+                Data written_value = 0;
+                execute(*op, pc, regs, written_reg, written_value, profile);
+            }
+#endif
+
+        stop_limit:
+            stop_reason = STOP_LIMIT;
+            goto done;
+        stop_breakpoint:
+            stop_reason = STOP_BREAKPOINT;
+            goto done;
+        stop_halt:
+            stop_reason = STOP_HALT;
+
+        done:
+            return finish(pc, regs, retired, stop_reason);
+        }
+
+        // Write the loop's local state back and summarize the run
+        RunResult finish(Pc pc, const Data* regs, uint64_t retired, StopReason stop_reason) {
+            RunResult result;
+            this->pc_ = pc;
+            result.pc = pc;
+            for (int i = 0; i < REGISTERS; ++i) {
+                this->regs_[i] = regs[i];
+                result.regs[i] = regs[i];
+            }
+            result.retired = retired;
+            result.stop_reason = stop_reason;
+            return result;
+        }
+
+        // Translate the basic block starting at entry_pc into blocks_[entry_pc]
+        void translateBlock(Pc entry_pc) {
+            Block& block = this->blocks_[entry_pc];
+
+            // Symbolic register file, starts as the identity: regs[k] = regs[k]
+            for (int k = 0; k < REGISTERS; ++k) {
+                block.constant[k] = 0;
+                for (int j = 0; j < REGISTERS; ++j) {
+                    block.coef[k][j] = (k == j) ? 1 : 0;
+                }
+            }
+            block.length = 0;
+            block.write_mask = 0;
+            block.ends_in_branch = false;
+            block.branch_rs2 = 0;
+            block.branch_target = 0;
+
+            Pc pc = entry_pc;
+            while (block.length < MAX_BLOCK_LENGTH) {
+                const MicroOp& op = this->uops_[pc];
+                block.length++;
+                pc = (pc + 1) & PC_MASK;
+
+                if (op.kind == OP_BNER0) {
+                    block.ends_in_branch = true;
+                    block.branch_rs2 = op.rs2;
+                    block.branch_target = op.target;
+                    break;
+                } else if (op.kind == OP_LOAD) {
+                    // Constant assignment
+                    block.constant[op.rd] = op.imm;
+                    for (int j = 0; j < REGISTERS; ++j) {
+                        block.coef[op.rd][j] = 0;
+                    }
+                    block.write_mask |= 1u << op.rd;
+                } else if (op.kind == OP_ADD) {
+                    // rd = rs1 + rs2 on the symbolic values (rd may alias a source)
+                    Data constant = (block.constant[op.rs1] + block.constant[op.rs2]) & DATA_MASK;
+                    Data coef[REGISTERS];
+                    for (int j = 0; j < REGISTERS; ++j) {
+                        coef[j] = (block.coef[op.rs1][j] + block.coef[op.rs2][j]) & DATA_MASK;
+                    }
+                    block.constant[op.rd] = constant;
+                    for (int j = 0; j < REGISTERS; ++j) {
+                        block.coef[op.rd][j] = coef[j];
+                    }
+                    block.write_mask |= 1u << op.rd;
+                }
+            }
+        }
+
         // Architectural state
-        uint8_t pc_;
-        uint8_t regs_[4];
+        Pc pc_;
+        Data regs_[REGISTERS];
 
-        // Instruction memory (raw bytes)
-        std::vector<uint8_t> imem_;
+        // Raw program words and their decoded form, indexed directly by the masked PC.
+        // Slots past the end of the program hold 0 and its decoded form.
+        Word imem_[ROM_SIZE];
+        MicroOp uops_[ROM_SIZE];
 
+        // Basic-block translation cache, indexed by entry PC; allocated by the first
+        // runBlocks, dropped by loadInstructions
+        std::vector<Block> blocks_;
 
- 
+        // Cycle detection in runBlocks enabled
+        bool fast_forward_;
 };
+
+// 8-bit PC over the 8-bit sISA encoding: branch targets 0..15, slots 16..255 read 0x00
+typedef sCPUSized<8, 4, 8, 4> sCPU;
+
+// Sized like the default main.sv: 4-bit PC (15 + 1 wraps to 0), 4 registers, 8-bit data
+typedef sCPUSized<4, 4, 8> sCPUMain;
+
+// Compiled once in sCPU.cpp
+extern template class sCPUSized<8, 4, 8, 4>;
+extern template class sCPUSized<4, 4, 8>;
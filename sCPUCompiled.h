@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "sCPU.h"
+
+// Golden model specialized for one fixed ROM image.
+// The implementation (sCPUCompiled.cpp) is generated by scpu_compile from a
+// program such as binary_data.txt: every PC becomes a label, every instruction
+// a direct register operation, and branches become gotos.
+// Same semantics and interface as sCPUMain (4-bit PC masked with PC_MASK, 16-entry ROM),
+// so the co-sim harness can use either one.
+class sCPUCompiled : public sCPUBase {
+    public:
+        typedef sCPUMain::MicroOp MicroOp;
+        typedef sCPUMain::RunResult RunResult;
+
+        static constexpr int PC_WIDTH = sCPUMain::PC_WIDTH;
+        static constexpr int REGISTER_COUNT = sCPUMain::REGISTER_COUNT;
+        static constexpr int DATA_WIDTH = sCPUMain::DATA_WIDTH;
+        static constexpr int FIELD_BITS = sCPUMain::FIELD_BITS;
+        static constexpr uint32_t PC_MASK = sCPUMain::PC_MASK;
+
+        static constexpr MicroOp decode(uint8_t instruction) {
+            return sCPUMain::decode(instruction);
+        }
+
+        sCPUCompiled();
+        ~sCPUCompiled();
+
+        // Get/Set PC
+        uint8_t getPc();
+        void setPc(uint8_t pc);
+
+        // Architectural state as one word (same layout as sCPUMain::getPackedState)
+        uint64_t getPackedState();
+
+        // Get/Set register values
+        uint8_t getRegister(uint8_t register_index);
+        void setRegister(uint8_t register_index, uint8_t register_value);
+
+        // The program is compiled in: only checks that bytes match the compiled image
+        void loadInstructions(const std::vector<uint8_t>& bytes);
+
+        // Helper: fetch 8-bit instruction at given address
+        uint8_t fetchInstruction(uint8_t index);
+
+        // Execute one instruction at PC
+        // Returns true if a register was written
+        // Also RETURNS which register and value were written via reference parameters
+        bool executeInstruction(uint8_t& written_reg, uint8_t& written_value);
+
+        // Same halt rules as sCPUMain::isHalted
+        bool isHalted();
+
+        // Execute up to max_instructions (same stop rules as sCPUMain::run)
+        RunResult run(uint64_t max_instructions);
+
+    private:
+        // Architectural state
+        uint8_t pc_;
+        uint8_t regs_[4];
+};
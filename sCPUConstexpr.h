@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sCPU.h"
+
+// Golden model usable in constant expressions: a literal-type shell around the constexpr
+// CPU::decode / CPU::execute / CPU::haltsAt of a sCPUSized configuration, so the semantics
+// and stop rules are those of the runtime model by construction. Storage is fixed-size, so a
+// program and its final state can be computed by the compiler, e.g.
+//
+//   constexpr uint8_t PROGRAM[] = { 0x8A, 0x90, 0xA0, 0xB1, 0x17, 0x29, 0xD1, 0xDF };
+//   constexpr sCPU::RunResult RESULT = sCPUConstexpr(PROGRAM).run(1000);
+//   static_assert(RESULT.regs[2] == 55, "sum loop");
+//
+// Compile-time runs are bounded by the compiler's constexpr step limit (a few million
+// instructions with GCC's default -fconstexpr-ops-limit).
+template <typename CPU>
+class sCPUConstexprSized {
+    public:
+        typedef typename CPU::Pc Pc;
+        typedef typename CPU::Data Data;
+        typedef typename CPU::Word Word;
+        typedef typename CPU::RunResult RunResult;
+
+        constexpr sCPUConstexprSized() : pc_(0), regs_{}, imem_{} {}
+
+        template <typename T, size_t N>
+        constexpr explicit sCPUConstexprSized(const T (&program)[N]) : sCPUConstexprSized() {
+            loadInstructions(program, N);
+        }
+
+        // Get/Set PC
+        constexpr Pc getPc() const { return this->pc_; }
+        constexpr void setPc(uint32_t pc) { this->pc_ = pc & CPU::PC_MASK; }
+
+        // Architectural state as one word (same layout as CPU::getPackedState)
+        constexpr uint64_t getPackedState() const {
+            uint64_t state = this->pc_ & 0xFF;
+            for (int i = 0; i < 4; ++i) {
+                state |= (uint64_t)this->regs_[i] << (8 + i * DATA_BITS);
+            }
+            return state;
+        }
+
+        // Get/Set register values
+        constexpr Data getRegister(uint32_t register_index) const {
+            return register_index < (uint32_t)REGISTERS ? this->regs_[register_index] : 0;
+        }
+        constexpr void setRegister(uint32_t register_index, uint32_t register_value) {
+            if (register_index < (uint32_t)REGISTERS) {
+                this->regs_[register_index] = register_value & CPU::DATA_MASK;
+            }
+        }
+
+        // Load program words; addresses past it read as 0 (add r0, r0, r0)
+        template <typename T>
+        constexpr void loadInstructions(const T* words, size_t size) {
+            for (uint32_t i = 0; i < CPU::ROM_SIZE; ++i) {
+                this->imem_[i] = i < size ? (Word)words[i] : 0;
+            }
+        }
+
+        // Helper: fetch instruction at given address
+        constexpr Word fetchInstruction(uint32_t index) const {
+            return this->imem_[index & CPU::PC_MASK];
+        }
+
+        // Execute one instruction at PC
+        // Returns true if a register was written
+        // Also RETURNS which register and value were written via reference parameters
+        template <typename RegisterOut, typename DataOut>
+        constexpr bool executeInstruction(RegisterOut& written_reg, DataOut& written_value) {
+            typename CPU::Register reg = 0;
+            Data value = 0;
+            typename CPU::NoProfile profile;
+            if (!CPU::execute(CPU::decode(this->imem_[this->pc_]), this->pc_, this->regs_, reg, value, profile)) {
+                return false;
+            }
+            written_reg = reg;
+            written_value = value;
+            return true;
+        }
+
+        // Same, without the written register
+        constexpr void step() {
+            typename CPU::Register written_reg = 0;
+            Data written_value = 0;
+            executeInstruction(written_reg, written_value);
+        }
+
+        // Same halt rules as CPU::isHalted
+        constexpr bool isHalted() const {
+            return CPU::haltsAt(CPU::decode(this->imem_[this->pc_]), this->pc_, this->regs_);
+        }
+
+        // Execute up to max_instructions (same stop rules and result as CPU::run)
+        constexpr RunResult run(uint64_t max_instructions) {
+            RunResult result = {};
+            result.stop_reason = CPU::STOP_LIMIT;
+            while (result.retired < max_instructions) {
+                result.retired++;
+                if (CPU::haltsAt(CPU::decode(this->imem_[this->pc_]), this->pc_, this->regs_)) {
+                    result.stop_reason = CPU::STOP_HALT;
+                    break;
+                }
+                step();
+            }
+            result.pc = this->pc_;
+            for (int i = 0; i < REGISTERS; ++i) {
+                result.regs[i] = this->regs_[i];
+            }
+            return result;
+        }
+
+    private:
+        static constexpr int REGISTERS = CPU::REGISTER_COUNT;
+        static constexpr int DATA_BITS = CPU::DATA_WIDTH;
+
+        // Architectural state
+        Pc pc_;
+        Data regs_[REGISTERS];
+
+        // Instruction memory, one word per PC value
+        Word imem_[CPU::ROM_SIZE];
+};
+
+// The 8-bit-PC configuration, compared against sCPU in sCPUConstexpr_test
+typedef sCPUConstexprSized<sCPU> sCPUConstexpr;
+
+// Final state of program run from reset, for constant expressions
+template <typename CPU = sCPU, typename T, size_t N>
+constexpr typename CPU::RunResult constexpr_run(const T (&program)[N], uint64_t max_instructions) {
+    return sCPUConstexprSized<CPU>(program).run(max_instructions);
+}
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "sCPU.h"
+#include "sCPUConstexpr.h"
+
+// Sum loop from main_test.cpp: r2 = 1 + 2 + ... + 10
+constexpr uint8_t SUM_LOOP[] = {
+    0b10001010,  // 0: li r0, 10
+    0b10010000,  // 1: li r1, 0
+    0b10100000,  // 2: li r2, 0
+    0b10110001,  // 3: li r3, 1
+    0b00010111,  // 4: add r1, r1, r3
+    0b00101001,  // 5: add r2, r2, r1
+    0b11010001,  // 6: bner0 r1, 4
+    0b11011111   // 7: bner0 r3, 7
+};
+
+// Evaluated by the compiler: a wrong model fails the build, not the test run
+constexpr sCPU::RunResult SUM_RESULT = constexpr_run(SUM_LOOP, 1000);
+static_assert(SUM_RESULT.stop_reason == sCPU::STOP_HALT, "sum loop halts");
+static_assert(SUM_RESULT.retired == 35, "sum loop retires 35 instructions");
+static_assert(SUM_RESULT.pc == 7, "sum loop halts on its branch-to-self");
+static_assert(SUM_RESULT.regs[0] == 10 && SUM_RESULT.regs[1] == 10 && SUM_RESULT.regs[2] == 55
+              && SUM_RESULT.regs[3] == 1, "sum loop final registers");
+
+// The 8-bit configurations decode through a table built at compile time
+constexpr bool decode_table_matches_fields() {
+    for (uint32_t i = 0; i < 256; i++) {
+        sCPU::MicroOp table = sCPU::decode(i);
+        sCPU::MicroOp fields = sCPU::decodeFields(i);
+        if (table.kind != fields.kind || table.rd != fields.rd || table.rs1 != fields.rs1 || table.rs2 != fields.rs2
+            || table.imm != fields.imm || table.target != fields.target) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(decode_table_matches_fields(), "decode table matches the field slicing");
+static_assert(sCPUMain::decode(0b11011111).target == 7 && sCPUMain::decode(0b11011111).rs2 == 3, "bner0 r3, 7");
+
+// Reference table precomputed at compile time: r2 after the sum loop with li r0, n
+struct SumTable {
+    uint8_t sums[16];
+    constexpr SumTable() : sums{} {
+        for (int n = 1; n < 16; n++) {
+            uint8_t program[8] = {};
+            for (int i = 0; i < 8; i++) {
+                program[i] = SUM_LOOP[i];
+            }
+            program[0] = 0b10000000 | n;
+            sums[n] = sCPUConstexpr(program).run(1000).regs[2];
+        }
+    }
+};
+constexpr SumTable SUM_TABLE;
+static_assert(SUM_TABLE.sums[1] == 1 && SUM_TABLE.sums[10] == 55 && SUM_TABLE.sums[15] == 120, "sum table");
+
+// Runs through the 0x00 slots (add r0, r0, r0) and wraps the 8-bit PC, as sCPU does
+constexpr uint8_t LOAD_ONLY[] = { 0b10010011 };  // li r1, 3
+static_assert(constexpr_run(LOAD_ONLY, 300).pc == 300 % 256, "PC wraps at 256");
+static_assert(constexpr_run(LOAD_ONLY, 300).regs[1] == 3, "load");
+
+// The lockstep configuration: the 4-bit PC wraps at 16
+static_assert(constexpr_run<sCPUMain>(LOAD_ONLY, 300).pc == 300 % 16, "PC wraps at 16");
+static_assert(constexpr_run<sCPUMain>(SUM_LOOP, 1000).retired == SUM_RESULT.retired, "same sum loop on sCPUMain");
+
+bool same_result(const sCPU::RunResult& a, const sCPU::RunResult& b) {
+    return a.retired == b.retired && a.pc == b.pc && a.stop_reason == b.stop_reason
+        && a.regs[0] == b.regs[0] && a.regs[1] == b.regs[1] && a.regs[2] == b.regs[2] && a.regs[3] == b.regs[3];
+}
+
+int main() {
+    std::cout << "Testing constexpr golden model\n";
+    std::cout << "==============================\n\n";
+
+    std::cout << "Test 1: Compile-time results (static_assert)\n";
+    std::cout << "  ✓ Sum loop: r2 = " << (int)SUM_RESULT.regs[2] << " after " << SUM_RESULT.retired
+              << " instructions, table of 15 sums\n\n";
+
+    // Test 2: same stop rules and state as sCPU::run on random programs, evaluated at runtime
+    std::cout << "Test 2: run() matches sCPU::run on 100000 random programs\n";
+    std::mt19937 rng(19);
+    for (int p = 0; p < 100000; p++) {
+        uint8_t program[16];
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        sCPU cpu;
+        cpu.loadInstructions(program, 16);
+        sCPUConstexpr constexpr_cpu(program);
+        uint64_t budget = rng() % 300;
+        if (!same_result(cpu.run(budget), constexpr_cpu.run(budget))
+            || cpu.isHalted() != constexpr_cpu.isHalted()) {
+            std::cerr << "  ✗ FAIL: program " << p << " differs from sCPU\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Identical results\n\n";
+
+    // Test 3: single steps
+    std::cout << "Test 3: executeInstruction() matches sCPU step by step\n";
+    for (int p = 0; p < 10000; p++) {
+        uint8_t program[16];
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        sCPU cpu;
+        cpu.loadInstructions(program, 16);
+        sCPUConstexpr constexpr_cpu(program);
+        for (int i = 0; i < 4; i++) {
+            uint8_t value = rng() & 0xFF;
+            cpu.setRegister(i, value);
+            constexpr_cpu.setRegister(i, value);
+        }
+        for (int step = 0; step < 64; step++) {
+            uint8_t reg_a = 0, value_a = 0, reg_b = 0, value_b = 0;
+            bool wrote_a = cpu.executeInstruction(reg_a, value_a);
+            bool wrote_b = constexpr_cpu.executeInstruction(reg_b, value_b);
+            if (wrote_a != wrote_b || (wrote_a && (reg_a != reg_b || value_a != value_b))
+                || cpu.getPackedState() != constexpr_cpu.getPackedState()) {
+                std::cerr << "  ✗ FAIL: program " << p << " differs at step " << step << "\n";
+                return 1;
+            }
+        }
+    }
+    std::cout << "  ✓ Identical states and register writes\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 sCPUConstexpr_test.cpp sCPU.cpp -o sCPUConstexpr_test
+./sCPUConstexpr_test
@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "sCPULanes.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Lane layout: each of the LANES CPUs owns byte i of every array, so one
+// vector operation advances VEC_BYTES CPUs at once. Divergent control flow
+// is handled with masked merges: every lane evaluates every instruction
+// type and keeps only the result selected by its own opcode.
+
+#if defined(__AVX2__)
+typedef __m256i vec_t;
+static const int VEC_BYTES = 32;
+static inline vec_t v_load(const uint8_t* p) { return _mm256_load_si256((const __m256i*)p); }
+static inline void v_store(uint8_t* p, vec_t v) { _mm256_store_si256((__m256i*)p, v); }
+static inline vec_t v_set1(uint8_t x) { return _mm256_set1_epi8((char)x); }
+static inline vec_t v_eq(vec_t a, vec_t b) { return _mm256_cmpeq_epi8(a, b); }
+static inline vec_t v_and(vec_t a, vec_t b) { return _mm256_and_si256(a, b); }
+static inline vec_t v_or(vec_t a, vec_t b) { return _mm256_or_si256(a, b); }
+static inline vec_t v_andnot(vec_t mask, vec_t a) { return _mm256_andnot_si256(mask, a); }
+static inline vec_t v_add(vec_t a, vec_t b) { return _mm256_add_epi8(a, b); }
+static inline vec_t v_blend(vec_t a, vec_t b, vec_t mask) { return _mm256_blendv_epi8(a, b, mask); }
+static inline vec_t v_srl(vec_t a, int n) { return v_and(_mm256_srli_epi16(a, n), v_set1((uint8_t)(0xFF >> n))); }
+#elif defined(__SSE2__)
+typedef __m128i vec_t;
+static const int VEC_BYTES = 16;
+static inline vec_t v_load(const uint8_t* p) { return _mm_load_si128((const __m128i*)p); }
+static inline void v_store(uint8_t* p, vec_t v) { _mm_store_si128((__m128i*)p, v); }
+static inline vec_t v_set1(uint8_t x) { return _mm_set1_epi8((char)x); }
+static inline vec_t v_eq(vec_t a, vec_t b) { return _mm_cmpeq_epi8(a, b); }
+static inline vec_t v_and(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+static inline vec_t v_or(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+static inline vec_t v_andnot(vec_t mask, vec_t a) { return _mm_andnot_si128(mask, a); }
+static inline vec_t v_add(vec_t a, vec_t b) { return _mm_add_epi8(a, b); }
+static inline vec_t v_blend(vec_t a, vec_t b, vec_t mask) { return v_or(v_and(mask, b), v_andnot(mask, a)); }
+static inline vec_t v_srl(vec_t a, int n) { return v_and(_mm_srli_epi16(a, n), v_set1((uint8_t)(0xFF >> n))); }
+#endif
+
+// Constructors
+sCPULanes::sCPULanes() {
+    std::memset(this->imem_, 0, sizeof(this->imem_));
+    std::memset(this->pc_, 0, sizeof(this->pc_));
+    std::memset(this->regs_, 0, sizeof(this->regs_));
+}
+
+// Destructor
+sCPULanes::~sCPULanes() {
+
+}
+
+// Get/Set PC of one lane
+uint8_t sCPULanes::getPc(int lane) {
+    return this->pc_[lane];
+}
+
+void sCPULanes::setPc(int lane, uint8_t pc) {
+    this->pc_[lane] = pc;
+}
+
+// Get/Set register values of one lane
+uint8_t sCPULanes::getRegister(int lane, uint8_t register_index) {
+    if (register_index < 4) {
+        return this->regs_[register_index][lane];
+    }
+    return 0;
+}
+
+void sCPULanes::setRegister(int lane, uint8_t register_index, uint8_t register_value) {
+    if (register_index < 4) {
+        this->regs_[register_index][lane] = register_value;
+    }
+}
+
+// Load program into one lane (bytes past IMEM_SIZE are ignored)
+void sCPULanes::loadInstructions(int lane, const std::vector<uint8_t>& bytes) {
+    for (int address = 0; address < IMEM_SIZE; ++address) {
+        this->imem_[address][lane] = address < (int)bytes.size() ? bytes[address] : 0;
+    }
+}
+
+// Execute one instruction in every lane
+void sCPULanes::step() {
+#if defined(__AVX2__) || defined(__SSE2__)
+    const vec_t reg_index[4] = { v_set1(0), v_set1(1), v_set1(2), v_set1(3) };
+    const vec_t one = v_set1(1);
+    const vec_t mask2 = v_set1(0x3);
+    const vec_t mask4 = v_set1(0xF);
+
+    for (int base = 0; base < LANES; base += VEC_BYTES) {
+        vec_t pc = v_load(&this->pc_[base]);
+        vec_t regs[4];
+        for (int r = 0; r < 4; ++r) {
+            regs[r] = v_load(&this->regs_[r][base]);
+        }
+
+        // Fetch: select imem_[pc] per lane; PCs past the ROM match nothing and read 0x00
+        vec_t instruction = v_set1(0);
+        for (int address = 0; address < IMEM_SIZE; ++address) {
+            vec_t hit = v_eq(pc, v_set1((uint8_t)address));
+            instruction = v_or(instruction, v_and(hit, v_load(&this->imem_[address][base])));
+        }
+
+        // Decode all fields in every lane
+        vec_t opcode = v_srl(instruction, 6);
+        vec_t rd = v_and(v_srl(instruction, 4), mask2);
+        vec_t rs1 = v_and(v_srl(instruction, 2), mask2);
+        vec_t rs2 = v_and(instruction, mask2);
+        vec_t imm = v_and(instruction, mask4);
+        vec_t target = v_and(v_srl(instruction, 2), mask4);
+
+        // Register reads by per-lane index
+        vec_t rs1_data = regs[0];
+        vec_t rs2_data = regs[0];
+        for (int r = 1; r < 4; ++r) {
+            rs1_data = v_blend(rs1_data, regs[r], v_eq(rs1, reg_index[r]));
+            rs2_data = v_blend(rs2_data, regs[r], v_eq(rs2, reg_index[r]));
+        }
+
+        vec_t is_add = v_eq(opcode, v_set1(0b00));
+        vec_t is_load = v_eq(opcode, v_set1(0b10));
+        vec_t is_branch = v_eq(opcode, v_set1(0b11));
+
+        // ADD and LOAD write rd; BNER0 and opcode 01 write nothing
+        vec_t write_data = v_blend(imm, v_add(rs1_data, rs2_data), is_add);
+        vec_t write_enable = v_or(is_add, is_load);
+
+        // BNER0: taken when rs2 != r0 (compared before the write-back, as in sCPU)
+        vec_t taken = v_andnot(v_eq(rs2_data, regs[0]), is_branch);
+        pc = v_blend(v_add(pc, one), target, taken);
+
+        for (int r = 0; r < 4; ++r) {
+            vec_t write_r = v_and(write_enable, v_eq(rd, reg_index[r]));
+            v_store(&this->regs_[r][base], v_blend(regs[r], write_data, write_r));
+        }
+        v_store(&this->pc_[base], pc);
+    }
+#else
+    // Scalar fallback: same semantics, one lane at a time
+    for (int lane = 0; lane < LANES; ++lane) {
+        uint8_t pc = this->pc_[lane];
+        uint8_t instruction = pc < IMEM_SIZE ? this->imem_[pc][lane] : 0;
+        uint8_t opcode = (instruction >> 6) & 0x3;
+
+        if (opcode == 0b10) {
+            this->regs_[(instruction >> 4) & 0x3][lane] = instruction & 0xF;
+            this->pc_[lane] = pc + 1;
+        } else if (opcode == 0b00) {
+            uint8_t result = this->regs_[(instruction >> 2) & 0x3][lane] + this->regs_[instruction & 0x3][lane];
+            this->regs_[(instruction >> 4) & 0x3][lane] = result;
+            this->pc_[lane] = pc + 1;
+        } else if (opcode == 0b11) {
+            if (this->regs_[instruction & 0x3][lane] != this->regs_[0][lane]) {
+                this->pc_[lane] = (instruction >> 2) & 0xF;
+            } else {
+                this->pc_[lane] = pc + 1;
+            }
+        } else {
+            this->pc_[lane] = pc + 1;
+        }
+    }
+#endif
+}
+
+// Execute instruction_count instructions in every lane
+void sCPULanes::run(uint64_t instruction_count) {
+    for (uint64_t i = 0; i < instruction_count; ++i) {
+        step();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays golden model: steps LANES independent sCPUs per instruction.
+// Same ISA semantics as sCPU; every lane holds its own program of up to 16 bytes
+// (the size of the RTL ROM), bytes past the program read as 0x00 like sCPU::fetchInstruction.
+// Uses AVX2 or SSE2 byte operations when available, a plain per-lane loop otherwise.
+class sCPULanes {
+    public:
+        static const int LANES = 32;
+        static const int IMEM_SIZE = 16;
+
+        sCPULanes();
+        ~sCPULanes();
+
+        // Get/Set PC of one lane
+        uint8_t getPc(int lane);
+        void setPc(int lane, uint8_t pc);
+
+        // Get/Set register values of one lane
+        uint8_t getRegister(int lane, uint8_t register_index);
+        void setRegister(int lane, uint8_t register_index, uint8_t register_value);
+
+        // Load program into one lane (bytes past IMEM_SIZE are ignored)
+        void loadInstructions(int lane, const std::vector<uint8_t>& bytes);
+
+        // Execute one instruction in every lane
+        void step();
+
+        // Execute instruction_count instructions in every lane
+        void run(uint64_t instruction_count);
+
+    private:
+        // One lane per byte: imem_[address][lane], pc_[lane], regs_[register][lane]
+        alignas(32) uint8_t imem_[IMEM_SIZE][LANES];
+        alignas(32) uint8_t pc_[LANES];
+        alignas(32) uint8_t regs_[4][LANES];
+};
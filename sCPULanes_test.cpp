@@ -0,0 +1,85 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "sCPU.h"
+#include "sCPULanes.h"
+
+// Compare every lane of sCPULanes against its own scalar sCPU
+bool compare_lanes(sCPULanes& lanes, std::vector<sCPU>& golden, int step) {
+    for (int lane = 0; lane < sCPULanes::LANES; lane++) {
+        bool match = lanes.getPc(lane) == golden[lane].getPc();
+        for (int i = 0; i < 4; i++) {
+            if (lanes.getRegister(lane, i) != golden[lane].getRegister(i)) {
+                match = false;
+            }
+        }
+        if (!match) {
+            std::cerr << "  ✗ FAIL: lane " << lane << " differs from sCPU after step " << step << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "Testing sCPULanes (SIMD lanes vs scalar sCPU)\n";
+    std::cout << "=============================================\n\n";
+
+    // Test 1: demo program from main_test.cpp in every lane
+    std::cout << "Test 1: Demo program in all " << sCPULanes::LANES << " lanes\n";
+    std::vector<uint8_t> demo = {
+        0b10001010,  // 0: li r0, 10
+        0b10010000,  // 1: li r1, 0
+        0b10100000,  // 2: li r2, 0
+        0b10110001,  // 3: li r3, 1
+        0b00010111,  // 4: add r1, r1, r3
+        0b00101001,  // 5: add r2, r2, r1
+        0b11010001,  // 6: bner0 r1, 4
+        0b11011111   // 7: bner0 r3, 7
+    };
+    sCPULanes lanes;
+    for (int lane = 0; lane < sCPULanes::LANES; lane++) {
+        lanes.loadInstructions(lane, demo);
+    }
+    lanes.run(40);
+    if (lanes.getRegister(0, 2) != 55 || lanes.getRegister(sCPULanes::LANES - 1, 2) != 55) {
+        std::cerr << "  ✗ FAIL: r2 should be 55, got " << (int)lanes.getRegister(0, 2) << "\n";
+        return 1;
+    }
+    std::cout << "  ✓ r2 = 55 in every lane\n\n";
+
+    // Test 2: random 16-byte programs and random initial state, one per lane
+    std::cout << "Test 2: Random programs, divergent control flow\n";
+    std::mt19937 rng(12345);
+    for (int round = 0; round < 200; round++) {
+        sCPULanes random_lanes;
+        std::vector<sCPU> golden(sCPULanes::LANES);
+        for (int lane = 0; lane < sCPULanes::LANES; lane++) {
+            std::vector<uint8_t> program(sCPULanes::IMEM_SIZE);
+            for (auto& byte : program) {
+                byte = rng() & 0xFF;
+            }
+            random_lanes.loadInstructions(lane, program);
+            golden[lane].loadInstructions(program);
+            for (int i = 0; i < 4; i++) {
+                uint8_t value = rng() & 0xFF;
+                random_lanes.setRegister(lane, i, value);
+                golden[lane].setRegister(i, value);
+            }
+        }
+        for (int step = 0; step < 300; step++) {
+            random_lanes.step();
+            for (int lane = 0; lane < sCPULanes::LANES; lane++) {
+                uint8_t written_reg, written_value;
+                golden[lane].executeInstruction(written_reg, written_value);
+            }
+            if (!compare_lanes(random_lanes, golden, step)) {
+                return 1;
+            }
+        }
+    }
+    std::cout << "  ✓ 200 x " << sCPULanes::LANES << " random programs match sCPU for 300 steps\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,2 @@
+g++ -O2 -march=native -std=c++17 sCPULanes_test.cpp sCPULanes.cpp sCPU.cpp -o sCPULanes_test
+./sCPULanes_test
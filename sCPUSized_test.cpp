@@ -0,0 +1,281 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "lockstep.h"
+#include "sCPU.h"
+#include "sCPUConstexpr.h"
+
+// Sum loop 1 + ... + n into r7, on a configuration with 8 registers
+template <typename CPU>
+std::vector<typename CPU::Word> wide_sum_loop(uint32_t n) {
+    return {
+        CPU::encodeLoad(0, n),      // 0: li r0, n
+        CPU::encodeLoad(1, 0),      // 1: li r1, 0
+        CPU::encodeLoad(7, 0),      // 2: li r7, 0
+        CPU::encodeLoad(5, 1),      // 3: li r5, 1
+        CPU::encodeAdd(1, 1, 5),    // 4: add r1, r1, r5
+        CPU::encodeAdd(7, 7, 1),    // 5: add r7, r7, r1
+        CPU::encodeBner0(1, 4),     // 6: bner0 r1, 4
+        CPU::encodeBner0(5, 7)      // 7: bner0 r5, 7
+    };
+}
+
+// Coverage sink keeping every sampled event
+struct EventLog {
+    std::vector<CoverageEvent> events;
+    void sample(const CoverageEvent& event) { events.push_back(event); }
+};
+
+// Reference for the batched loops: executeInstruction one step at a time, same stop rules
+template <typename CPU>
+typename CPU::RunResult step_until(CPU& cpu, uint64_t max_instructions, uint32_t stop_pc) {
+    typename CPU::RunResult result = {};
+    result.stop_reason = CPU::STOP_LIMIT;
+    while (result.retired < max_instructions) {
+        if (cpu.getPc() == stop_pc) {
+            result.stop_reason = CPU::STOP_BREAKPOINT;
+            break;
+        }
+        const typename CPU::MicroOp op = CPU::decode(cpu.fetchInstruction(cpu.getPc()));
+        result.retired++;
+        if (op.kind == CPU::OP_BNER0 && op.target == cpu.getPc() && cpu.getRegister(op.rs2) != cpu.getRegister(0)) {
+            result.stop_reason = CPU::STOP_HALT;
+            break;
+        }
+        uint32_t written_reg, written_value;
+        cpu.executeInstruction(written_reg, written_value);
+    }
+    result.pc = cpu.getPc();
+    for (int i = 0; i < CPU::REGISTER_COUNT; i++) {
+        result.regs[i] = cpu.getRegister(i);
+    }
+    return result;
+}
+
+template <typename CPU>
+bool same_result(const typename CPU::RunResult& a, const typename CPU::RunResult& b) {
+    bool match = a.retired == b.retired && a.pc == b.pc && a.stop_reason == b.stop_reason;
+    for (int i = 0; i < CPU::REGISTER_COUNT; i++) {
+        match = match && a.regs[i] == b.regs[i];
+    }
+    return match;
+}
+
+// run, runUntil, runBlocks (with and without fast-forward) and the constexpr model against
+// single steps on random full ROMs, so every execution mode crosses the PC wrap
+template <typename CPU>
+bool fast_paths_match(std::mt19937& rng, int programs, const char* name) {
+    for (int p = 0; p < programs; p++) {
+        std::vector<typename CPU::Word> program(CPU::ROM_SIZE);
+        for (typename CPU::Word& word : program) {
+            word = rng() & ((1u << CPU::INSTRUCTION_BITS) - 1);
+        }
+        uint64_t budget = rng() % 2000;
+        uint32_t stop_pc = p % 2 == 0 ? CPU::ROM_SIZE : rng() % CPU::ROM_SIZE;
+        CPU stepped, looped, blocks, forwarded;
+        stepped.loadInstructions(program);
+        looped.loadInstructions(program);
+        blocks.loadInstructions(program);
+        forwarded.loadInstructions(program);
+        forwarded.setFastForward(true);
+        sCPUConstexprSized<CPU> constant;
+        constant.loadInstructions(program.data(), program.size());
+        for (int i = 0; i < CPU::REGISTER_COUNT; i++) {
+            uint32_t value = rng();
+            stepped.setRegister(i, value);
+            looped.setRegister(i, value);
+            blocks.setRegister(i, value);
+            forwarded.setRegister(i, value);
+            constant.setRegister(i, value);
+        }
+        typename CPU::RunResult expected = step_until(stepped, budget, stop_pc);
+        typename CPU::RunResult batched = looped.runUntil(budget, stop_pc);
+        if (!same_result<CPU>(batched, expected) || looped.isHalted() != stepped.isHalted()) {
+            std::cerr << "  ✗ FAIL: " << name << " program " << p << " runUntil differs\n";
+            return false;
+        }
+        if (stop_pc != CPU::ROM_SIZE) {
+            continue;
+        }
+        if (!same_result<CPU>(blocks.runBlocks(budget), expected) || !same_result<CPU>(forwarded.runBlocks(budget), expected)
+            || !same_result<CPU>(constant.run(budget), expected) || constant.isHalted() != stepped.isHalted()) {
+            std::cerr << "  ✗ FAIL: " << name << " program " << p << " runBlocks / constexpr run differs\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "Testing width-parameterized golden model\n";
+    std::cout << "========================================\n\n";
+
+    // Test 1: default main.sv size behaves like sCPU while the program stays in the ROM
+    std::cout << "Test 1: sCPUMain matches sCPU on 100000 random programs ending before slot 15\n";
+    static_assert(sCPUMain::INSTRUCTION_BITS == 8 && sCPUMain::ROM_SIZE == 16, "default encoding");
+    std::mt19937 rng(20);
+    for (int p = 0; p < 100000; p++) {
+        std::vector<uint8_t> program(15);
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        sCPU cpu;
+        sCPUMain sized;
+        cpu.loadInstructions(program);
+        sized.loadInstructions(program);
+        // Only while PC < 15: from slot 15, sCPU moves on to 16 while sCPUMain wraps to 0
+        for (int step = 0; step < 64 && !cpu.isHalted() && cpu.getPc() < 15; step++) {
+            uint8_t reg_a = 0, value_a = 0, reg_b = 0, value_b = 0;
+            bool wrote_a = cpu.executeInstruction(reg_a, value_a);
+            bool wrote_b = sized.executeInstruction(reg_b, value_b);
+            if (wrote_a != wrote_b || (wrote_a && (reg_a != reg_b || value_a != value_b))
+                || cpu.getPackedState() != sized.getPackedState() || cpu.isHalted() != sized.isHalted()) {
+                std::cerr << "  ✗ FAIL: program " << p << " differs at step " << step << "\n";
+                return 1;
+            }
+        }
+
+        sCPU batched;
+        sCPUMain sized_batched;
+        batched.loadInstructions(program);
+        sized_batched.loadInstructions(program);
+        sCPU::RunResult a = batched.run(64);
+        sCPUMain::RunResult b = sized_batched.run(64);
+        // Halted on a branch-to-self: the program never left slots 0..15, where the PCs agree
+        if (a.stop_reason == sCPU::STOP_HALT && (a.retired != b.retired || a.pc != b.pc || a.stop_reason != b.stop_reason
+                                   || batched.getPackedState() != sized_batched.getPackedState())) {
+            std::cerr << "  ✗ FAIL: program " << p << " run() differs\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Identical steps and runs\n\n";
+
+    // Test 2: PC wraps from 15 to 0 like program_counter.sv
+    std::cout << "Test 2: PC 15 + 1 wraps to 0\n";
+    {
+        std::vector<uint8_t> program(16, 0b01000000);   // NOPs
+        program[15] = 0b10010101;                       // 15: li r1, 5
+        sCPUMain cpu;
+        cpu.loadInstructions(program);
+        cpu.setPc(15);
+        uint8_t written_reg = 0, written_value = 0;
+        cpu.executeInstruction(written_reg, written_value);
+        sCPUMain::RunResult result = cpu.run(16 + 3);
+        if (cpu.getRegister(1) != 5 || result.pc != 3 || cpu.isHalted() || result.stop_reason != sCPU::STOP_LIMIT) {
+            std::cerr << "  ✗ FAIL: PC " << (int)result.pc << " after wrapping\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ PC 0 after slot 15\n\n";
+
+    // Test 3: 8-bit PC, 8 registers, 16-bit data
+    std::cout << "Test 3: sCPUSized<8, 8, 16> sum loop\n";
+    {
+        typedef sCPUSized<8, 8, 16> Wide;
+        static_assert(Wide::INSTRUCTION_BITS == 13 && Wide::ROM_SIZE == 256, "wide encoding");
+        Wide cpu;
+        cpu.loadInstructions(wide_sum_loop<Wide>(200));
+        Wide::RunResult result = cpu.run(10000);
+        if (result.stop_reason != sCPU::STOP_HALT || result.regs[7] != 20100 || result.pc != 7) {
+            std::cerr << "  ✗ FAIL: r7 = " << result.regs[7] << "\n";
+            return 1;
+        }
+        std::cout << "  ✓ r7 = " << result.regs[7] << " after " << result.retired << " instructions\n";
+
+        // Results wrap at the data width
+        typedef sCPUSized<8, 8, 12> Narrow;
+        Narrow narrow;
+        narrow.loadInstructions(wide_sum_loop<Narrow>(200));
+        if (narrow.run(10000).regs[7] != 20100 % 4096) {
+            std::cerr << "  ✗ FAIL: 12-bit data does not wrap\n";
+            return 1;
+        }
+        std::cout << "  ✓ 12-bit data: r7 = 20100 mod 4096\n";
+
+        // A program filling all 256 slots wraps from 255 to 0
+        std::vector<Wide::Word> full(256, Wide::encodeLoad(2, 1));
+        Wide wrapping;
+        wrapping.loadInstructions(full);
+        if (wrapping.run(256 + 10).pc != 10) {
+            std::cerr << "  ✗ FAIL: 8-bit PC does not wrap\n";
+            return 1;
+        }
+        std::cout << "  ✓ PC 255 + 1 wraps to 0\n\n";
+    }
+
+    // Test 4: register indices are checked against the register count
+    std::cout << "Test 4: Register bounds\n";
+    {
+        sCPU cpu;
+        cpu.setRegister(3, 9);
+        cpu.setRegister(5, 7);
+        sCPUMain sized;
+        sized.setRegister(6, 7);
+        if (cpu.getRegister(5) != 0 || cpu.getRegister(3) != 9 || sized.getRegister(6) != 0
+            || cpu.getPackedState() != ((uint64_t)9 << 32)) {
+            std::cerr << "  ✗ FAIL: out-of-range register index accepted\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Indices past R3 read 0 and are not written\n\n";
+
+    // Test 5: every execution mode of the sized models, across the PC wrap
+    std::cout << "Test 5: Fast paths vs single steps on full ROMs\n";
+    {
+        std::mt19937 paths_rng(21);
+        if (!fast_paths_match<sCPUMain>(paths_rng, 20000, "sCPUMain")
+            || !fast_paths_match<sCPUSized<8, 8, 16> >(paths_rng, 2000, "sCPUSized<8, 8, 16>")
+            || !fast_paths_match<sCPUSized<6, 16, 32> >(paths_rng, 2000, "sCPUSized<6, 16, 32>")) {
+            return 1;
+        }
+    }
+    std::cout << "  ✓ run, runUntil, runBlocks, fast-forward and sCPUConstexprSized agree\n\n";
+
+    // Test 6: the lockstep adapter decodes with the configuration's own fields (12-bit
+    // instructions with an 8-bit operand field; the observers need 4 registers, 8-bit data)
+    std::cout << "Test 6: GoldenAdapter on sCPUSized<8, 4, 8>\n";
+    {
+        typedef sCPUSized<8, 4, 8> Wide;
+        static_assert(Wide::FIELD_BITS == 8 && Wide::INSTRUCTION_BITS == 12, "wide operand field");
+        static_assert(!GoldenAdapter<sCPUSized<8, 8, 16> >::OBSERVABLE, "8 registers of 16 bits do not fit");
+        const std::vector<Wide::Word> program = {
+            Wide::encodeLoad(0, 3),     // 0: li r0, 3
+            Wide::encodeLoad(1, 0),     // 1: li r1, 0
+            Wide::encodeLoad(3, 0),     // 2: li r3, 0
+            Wide::encodeLoad(2, 1),     // 3: li r2, 1
+            Wide::encodeAdd(1, 1, 2),   // 4: add r1, r1, r2
+            Wide::encodeAdd(3, 3, 1),   // 5: add r3, r3, r1
+            Wide::encodeBner0(1, 4),    // 6: bner0 r1, 4
+            Wide::encodeBner0(2, 7)     // 7: bner0 r2, 7
+        };
+        Wide committed, covered;
+        committed.loadInstructions(program);
+        covered.loadInstructions(program);
+        GoldenAdapter<Wide> commit_adapter(committed);
+        GoldenAdapter<Wide> cover_adapter(covered);
+        std::vector<CommitRecord> records;
+        EventLog log;
+        for (int cycle = 0; cycle < 12; cycle++) {
+            CommitRecord record = {};
+            commit_adapter.commit(record);
+            records.push_back(record);
+            cover_adapter.cover(log);
+        }
+        // 0-3 loads, 4 add r1, 5 add r3, 6 bner0 r1, 4 (taken), 4, 5, 6 (taken), 4, 5
+        const CoverageEvent& add = log.events[5];
+        const CoverageEvent& branch = log.events[6];
+        if (records[2].rd != 3 || !records[2].written || records[5].rd != 3 || records[5].value != 1
+            || !records[6].branch_taken || records[6].written || add.rd != 3 || add.rs1 != 3 || add.rs2 != 1
+            || branch.kind != Wide::OP_BNER0 || !branch.taken || branch.next_pc != 4 || branch.rs2 != 1
+            || log.events[2].rd != 3 || log.events[3].rd != 2) {
+            std::cerr << "  ✗ FAIL: commit rd " << (int)records[5].rd << ", cover rd " << (int)add.rd << ", taken "
+                      << records[6].branch_taken << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ rd r3 / r2, taken bner0 r1, 4 in commit records and coverage events\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
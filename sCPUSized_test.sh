@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 sCPUSized_test.cpp sCPU.cpp -o sCPUSized_test
+./sCPUSized_test
@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "sCPU.h"
+
+// Sum loop from main_test.cpp: r2 = 1 + 2 + ... + 10
+const std::vector<uint8_t> SUM_LOOP = {
+    0b10001010,  // 0: li r0, 10
+    0b10010000,  // 1: li r1, 0
+    0b10100000,  // 2: li r2, 0
+    0b10110001,  // 3: li r3, 1
+    0b00010111,  // 4: add r1, r1, r3
+    0b00101001,  // 5: add r2, r2, r1
+    0b11010001,  // 6: bner0 r1, 4
+    0b11011111   // 7: bner0 r3, 7
+};
+
+// A policy of the caller's own: counts taken branches only
+struct TakenBranches {
+    uint64_t taken = 0;
+    void retire(uint8_t, uint8_t) {}
+    void branch(uint8_t, bool is_taken) { this->taken += is_taken; }
+    void write(uint8_t) {}
+};
+
+bool same_profile(const sCPU::Profile& a, const sCPU::Profile& b) {
+    std::ostringstream text_a, text_b;
+    a.writeCsv(text_a);
+    b.writeCsv(text_b);
+    return text_a.str() == text_b.str();
+}
+
+int main() {
+    std::cout << "Testing sCPU execution profiling\n";
+    std::cout << "================================\n\n";
+
+    // Test 1: counters of the sum loop
+    std::cout << "Test 1: Sum loop profile\n";
+    sCPU cpu;
+    cpu.loadInstructions(SUM_LOOP);
+    sCPU::Profile profile;
+    sCPU::RunResult result = cpu.run(1000, profile);
+    // 4 loads, 10 iterations of add/add/bner0, then the halt branch
+    bool ok = result.stop_reason == sCPU::STOP_HALT && result.retired == 35 && profile.retired() == 35
+           && profile.opcode[sCPU::OP_LOAD] == 4 && profile.opcode[sCPU::OP_ADD] == 20
+           && profile.opcode[sCPU::OP_BNER0] == 11 && profile.opcode[sCPU::OP_NOP] == 0
+           && profile.pc_hits[0] == 1 && profile.pc_hits[4] == 10 && profile.pc_hits[6] == 10
+           && profile.pc_hits[7] == 1 && profile.pc_hits[8] == 0
+           && profile.branch_taken[6] == 9 && profile.branch_not_taken[6] == 1
+           && profile.branch_taken[7] == 1 && profile.branch_not_taken[7] == 0
+           && profile.register_writes[0] == 1 && profile.register_writes[1] == 11
+           && profile.register_writes[2] == 11 && profile.register_writes[3] == 1
+           && cpu.getRegister(2) == 55;
+    if (!ok) {
+        std::cerr << "  ✗ FAIL: unexpected profile\n";
+        profile.writeCsv(std::cerr);
+        return 1;
+    }
+    std::cout << "  ✓ 35 retired, BNER0 at PC 6 taken 9 / not taken 1\n\n";
+
+    // Test 2: CSV export
+    std::cout << "Test 2: CSV export\n";
+    std::ostringstream csv;
+    profile.writeCsv(csv);
+    if (csv.str().find("opcode,add,20\n") == std::string::npos
+        || csv.str().find("branch_taken,6,9\n") == std::string::npos
+        || csv.str().find("register_write,r2,11\n") == std::string::npos
+        || csv.str().find("pc,8,") != std::string::npos) {
+        std::cerr << "  ✗ FAIL: unexpected CSV\n" << csv.str();
+        return 1;
+    }
+    std::cout << "  ✓ Non-zero counters exported\n\n";
+
+    // Test 3: step-by-step and run loop count the same on random programs
+    std::cout << "Test 3: executeInstruction and run agree on 10000 random programs\n";
+    std::mt19937 rng(7);
+    sCPU::Profile stepped_total, run_total;
+    for (int p = 0; p < 10000; p++) {
+        std::vector<uint8_t> program(16);
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        sCPU stepped, batched;
+        stepped.loadInstructions(program);
+        batched.loadInstructions(program);
+
+        sCPU::Profile stepped_profile, run_profile;
+        uint64_t retired = batched.run(256, run_profile).retired;
+        uint8_t written_reg, written_value;
+        for (uint64_t i = 0; i < retired; i++) {
+            stepped.executeInstruction(written_reg, written_value, stepped_profile);
+        }
+        if (!same_profile(stepped_profile, run_profile) || run_profile.retired() != retired) {
+            std::cerr << "  ✗ FAIL: profiles differ on program " << p << "\n";
+            return 1;
+        }
+        stepped_total.add(stepped_profile);
+        run_total.add(run_profile);
+    }
+    if (!same_profile(stepped_total, run_total)) {
+        std::cerr << "  ✗ FAIL: merged profiles differ\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << run_total.retired() << " instructions, identical profiles\n\n";
+
+    // Test 4: clear
+    std::cout << "Test 4: Clear\n";
+    run_total.clear();
+    if (run_total.retired() != 0 || !same_profile(run_total, sCPU::Profile())) {
+        std::cerr << "  ✗ FAIL: counters left after clear\n";
+        return 1;
+    }
+    std::cout << "  ✓ All counters zero\n\n";
+
+    // Test 5: profiled runUntil, and a policy defined outside sCPU
+    std::cout << "Test 5: runUntil with Profile and a custom policy\n";
+    sCPU until;
+    until.loadInstructions(SUM_LOOP);
+    sCPU::Profile until_profile;
+    sCPU::RunResult stopped = until.runUntil(1000, 6, until_profile);
+    TakenBranches branches;
+    sCPU::RunResult halted = until.runUntil(1000, 12, branches);
+    if (stopped.stop_reason != sCPU::STOP_BREAKPOINT || until_profile.retired() != 6 || until_profile.pc_hits[6] != 0
+        || halted.stop_reason != sCPU::STOP_HALT || branches.taken != 10) {
+        std::cerr << "  ✗ FAIL: " << until_profile.retired() << " instructions to the breakpoint, "
+                  << branches.taken << " taken branches after it\n";
+        return 1;
+    }
+    std::cout << "  ✓ 6 instructions up to PC 6, then 10 taken branches (9 loop + halt)\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
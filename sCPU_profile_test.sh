@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 sCPU_profile_test.cpp sCPU.cpp -o sCPU_profile_test
+./sCPU_profile_test
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "sCPU.h"
+
+// Example program of instruction_memory.sv: r2 = 1 + ... + 10, then halts at PC 7
+const std::vector<uint8_t> SUM_LOOP = {
+    0b10001010,  // 0: li r0, 10
+    0b10010000,  // 1: li r1, 0
+    0b10100000,  // 2: li r2, 0
+    0b10110001,  // 3: li r3, 1
+    0b00010111,  // 4: add r1, r1, r3
+    0b00101001,  // 5: add r2, r2, r1
+    0b11010001,  // 6: bner0 r1, 4
+    0b11011111   // 7: bner0 r3, 7
+};
+
+std::vector<uint8_t> random_program(std::mt19937& rng, size_t size = 16) {
+    std::vector<uint8_t> program(size);
+    for (uint8_t& byte : program) {
+        byte = rng() & 0xFF;
+    }
+    return program;
+}
+
+// Reference for run / runUntil: executeInstruction one step at a time with the same stop
+// rules (limit first, then the breakpoint before executing, then a taken branch to itself)
+sCPU::RunResult step_until(sCPU& cpu, uint64_t max_instructions, int stop_pc) {
+    sCPU::RunResult result = {};
+    result.stop_reason = sCPU::STOP_LIMIT;
+    while (result.retired < max_instructions) {
+        if (cpu.getPc() == stop_pc) {
+            result.stop_reason = sCPU::STOP_BREAKPOINT;
+            break;
+        }
+        const sCPU::MicroOp op = sCPU::decode(cpu.fetchInstruction(cpu.getPc()));
+        result.retired++;
+        if (op.kind == sCPU::OP_BNER0 && op.target == cpu.getPc() && cpu.getRegister(op.rs2) != cpu.getRegister(0)) {
+            result.stop_reason = sCPU::STOP_HALT;
+            break;
+        }
+        uint8_t written_reg, written_value;
+        cpu.executeInstruction(written_reg, written_value);
+    }
+    result.pc = cpu.getPc();
+    for (int i = 0; i < 4; i++) {
+        result.regs[i] = cpu.getRegister(i);
+    }
+    return result;
+}
+
+bool same_result(const sCPU::RunResult& a, const sCPU::RunResult& b) {
+    bool match = a.retired == b.retired && a.pc == b.pc && a.stop_reason == b.stop_reason;
+    for (int i = 0; i < 4; i++) {
+        match = match && a.regs[i] == b.regs[i];
+    }
+    return match;
+}
+
+void print_result(const char* name, const sCPU::RunResult& result) {
+    std::cerr << "    " << name << ": retired " << result.retired << ", PC " << (int)result.pc << ", stop "
+              << (int)result.stop_reason << ", regs " << (int)result.regs[0] << " " << (int)result.regs[1] << " "
+              << (int)result.regs[2] << " " << (int)result.regs[3] << "\n";
+}
+
+int main() {
+    std::cout << "Testing sCPU batched runs\n";
+    std::cout << "=========================\n\n";
+
+    // Test 1: a breakpoint stops before the instruction at stop_pc runs
+    std::cout << "Test 1: runUntil stops at the breakpoint (STOP_BREAKPOINT)\n";
+    sCPU cpu;
+    cpu.loadInstructions(SUM_LOOP);
+    sCPU::RunResult first = cpu.runUntil(1000, 6);
+    if (first.stop_reason != sCPU::STOP_BREAKPOINT || first.retired != 6 || first.pc != 6
+        || first.regs[1] != 1 || first.regs[2] != 1) {
+        std::cerr << "  ✗ FAIL: expected a stop before bner0 at PC 6 after 6 instructions\n";
+        print_result("runUntil", first);
+        return 1;
+    }
+    // Already at the breakpoint: nothing runs; one step past it reaches it again next iteration
+    sCPU::RunResult again = cpu.runUntil(1000, 6);
+    uint8_t written_reg, written_value;
+    cpu.executeInstruction(written_reg, written_value);
+    sCPU::RunResult next = cpu.runUntil(1000, 6);
+    if (again.stop_reason != sCPU::STOP_BREAKPOINT || again.retired != 0
+        || next.stop_reason != sCPU::STOP_BREAKPOINT || next.retired != 2 || next.regs[1] != 2 || next.regs[2] != 3) {
+        std::cerr << "  ✗ FAIL: breakpoint at the current PC or the next loop iteration\n";
+        print_result("again", again);
+        print_result("next", next);
+        return 1;
+    }
+    std::cout << "  ✓ 6 instructions, bner0 at PC 6 not executed; re-entry stops after 0, then 2\n\n";
+
+    // Test 2: the halting branch is executed and counted
+    std::cout << "Test 2: Taken branch to itself (STOP_HALT)\n";
+    sCPU halting;
+    halting.loadInstructions(SUM_LOOP);
+    sCPU::RunResult halted = halting.runUntil(1000, 12);     // breakpoint never reached
+    sCPU exact;
+    exact.loadInstructions(SUM_LOOP);
+    sCPU::RunResult exact_budget = exact.runUntil(35, 12);
+    sCPU short_of;
+    short_of.loadInstructions(SUM_LOOP);
+    sCPU::RunResult one_short = short_of.runUntil(34, 12);
+    if (halted.stop_reason != sCPU::STOP_HALT || halted.retired != 35 || halted.pc != 7 || halted.regs[2] != 55
+        || !same_result(halted, exact_budget) || one_short.stop_reason != sCPU::STOP_LIMIT
+        || one_short.retired != 34 || one_short.pc != 7) {
+        std::cerr << "  ✗ FAIL: expected a halt at PC 7 after 35 instructions (4 + 10 x 3 + the halt)\n";
+        print_result("budget 1000", halted);
+        print_result("budget 35", exact_budget);
+        print_result("budget 34", one_short);
+        return 1;
+    }
+    std::cout << "  ✓ 35 instructions including bner0 r3, 7; a budget of 34 stops at the limit\n\n";
+
+    // Test 3: run / runUntil against single steps on random programs and breakpoints
+    std::cout << "Test 3: run / runUntil vs executeInstruction, random programs\n";
+    std::mt19937 rng(2);
+    int stops[3] = { 0, 0, 0 };
+    for (int round = 0; round < 20000; round++) {
+        std::vector<uint8_t> program = random_program(rng);
+        uint64_t budget = rng() % 400;
+        int stop_pc = round % 4 == 0 ? 256 : rng() % 20;    // 256: run, no breakpoint
+        sCPU batched, stepped;
+        batched.loadInstructions(program);
+        stepped.loadInstructions(program);
+        for (int i = 0; i < 4; i++) {
+            uint8_t value = rng() & 0xFF;
+            batched.setRegister(i, value);
+            stepped.setRegister(i, value);
+        }
+        sCPU::RunResult result = stop_pc == 256 ? batched.run(budget) : batched.runUntil(budget, stop_pc);
+        sCPU::RunResult expected = step_until(stepped, budget, stop_pc);
+        if (!same_result(result, expected) || batched.getPackedState() != stepped.getPackedState()) {
+            std::cerr << "  ✗ FAIL: round " << round << ", budget " << budget << ", stop PC " << stop_pc << "\n";
+            print_result("batched", result);
+            print_result("stepped", expected);
+            return 1;
+        }
+        stops[result.stop_reason]++;
+    }
+    std::cout << "  ✓ 20000 programs: " << stops[sCPU::STOP_LIMIT] << " limit, " << stops[sCPU::STOP_BREAKPOINT]
+              << " breakpoint, " << stops[sCPU::STOP_HALT] << " halt stops all match\n\n";
+
+    // Test 4: block translation against run and single steps; one CPU is reloaded every
+    // round (stale blocks would show), budgets often end inside a block
+    std::cout << "Test 4: runBlocks vs run / executeInstruction, random programs\n";
+    sCPU blocks;
+    uint64_t slices = 0;
+    for (int round = 0; round < 20000; round++) {
+        std::vector<uint8_t> program = random_program(rng, round % 8 == 0 ? 256 : 16);
+        uint64_t budget = rng() % 400;
+        sCPU reference, stepped;
+        blocks.loadInstructions(program);
+        reference.loadInstructions(program);
+        stepped.loadInstructions(program);
+        blocks.setPc(0);
+        for (int i = 0; i < 4; i++) {
+            uint8_t value = rng() & 0xFF;
+            blocks.setRegister(i, value);
+            reference.setRegister(i, value);
+            stepped.setRegister(i, value);
+        }
+        // The budget in random slices: every slice boundary may split a block
+        sCPU::RunResult result = {};
+        uint64_t left = budget;
+        do {
+            uint64_t slice = round % 2 == 0 ? left : std::min<uint64_t>(left, rng() % 8);
+            sCPU::RunResult part = blocks.runBlocks(slice);
+            result.retired += part.retired;
+            result.pc = part.pc;
+            result.stop_reason = part.stop_reason;
+            for (int i = 0; i < 4; i++) {
+                result.regs[i] = part.regs[i];
+            }
+            left -= part.retired;
+            slices++;
+        } while (left > 0 && result.stop_reason == sCPU::STOP_LIMIT);
+        sCPU::RunResult expected = reference.run(budget);
+        sCPU::RunResult expected_steps = step_until(stepped, budget, 256);
+        if (!same_result(result, expected) || !same_result(result, expected_steps)
+            || blocks.getPackedState() != reference.getPackedState()) {
+            std::cerr << "  ✗ FAIL: round " << round << ", budget " << budget << "\n";
+            print_result("runBlocks", result);
+            print_result("run", expected);
+            print_result("stepped", expected_steps);
+            return 1;
+        }
+    }
+    std::cout << "  ✓ 20000 programs on one reloaded CPU match (" << slices << " runBlocks slices)\n\n";
+
+    // Test 5: cycle fast-forward skips whole periods; long budgets must still end in the
+    // exact state, retired count and stop reason of the plain loop
+    std::cout << "Test 5: runBlocks with fast-forward vs run, budgets up to 4M instructions\n";
+    sCPU forwarded;
+    forwarded.setFastForward(true);
+    uint64_t total = 0;
+    for (int round = 0; round < 400; round++) {
+        std::vector<uint8_t> program = random_program(rng, round % 4 == 0 ? 256 : 16);
+        uint64_t budget = round % 10 == 0 ? 4000000 - round : rng() % 4000000;
+        sCPU reference;
+        forwarded.loadInstructions(program);
+        reference.loadInstructions(program);
+        forwarded.setPc(0);
+        for (int i = 0; i < 4; i++) {
+            uint8_t value = rng() & 0xFF;
+            forwarded.setRegister(i, value);
+            reference.setRegister(i, value);
+        }
+        sCPU::RunResult result = forwarded.runBlocks(budget);
+        sCPU::RunResult expected = reference.run(budget);
+        if (!same_result(result, expected) || forwarded.getPackedState() != reference.getPackedState()) {
+            std::cerr << "  ✗ FAIL: round " << round << ", budget " << budget << "\n";
+            print_result("fast-forward", result);
+            print_result("run", expected);
+            return 1;
+        }
+        total += result.retired;
+    }
+    std::cout << "  ✓ 400 programs, " << total << " instructions retired in both\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
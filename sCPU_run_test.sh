@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 sCPU_run_test.cpp sCPU.cpp -o sCPU_run_test
+./sCPU_run_test
@@ -0,0 +1,288 @@
+// Ahead-of-time compiler for sISA programs.
+// Reads a ROM image and writes sCPUCompiled.cpp, the implementation of the
+// sCPUCompiled golden model (see sCPUCompiled.h) specialized for that image.
+// The generated code is sCPUMain with the program compiled in: 16-entry ROM, PC masked
+// with PC_MASK, so PC 15 + 1 wraps to 0 as in program_counter.sv.
+//
+// Usage:
+//   ./scpu_compile binary_data.txt sCPUCompiled.cpp        (text, see rom_image.h)
+//   ./scpu_compile --raw program.bin sCPUCompiled.cpp      (raw bytes)
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "rom_image.h"
+#include "sCPU.h"
+
+// Assembly text for one instruction, e.g. "add r1, r1, r3"
+std::string disassemble(uint8_t instruction) {
+    const sCPUMain::MicroOp op = sCPUMain::decode(instruction);
+    std::ostringstream text;
+    switch (op.kind) {
+        case sCPUMain::OP_LOAD:
+            text << "li r" << (int)op.rd << ", " << (int)op.imm;
+            break;
+        case sCPUMain::OP_ADD:
+            text << "add r" << (int)op.rd << ", r" << (int)op.rs1 << ", r" << (int)op.rs2;
+            break;
+        case sCPUMain::OP_BNER0:
+            text << "bner0 r" << (int)op.rs2 << ", " << (int)op.target;
+            break;
+        default:
+            text << "nop";
+            break;
+    }
+    return text.str();
+}
+
+std::string binary_literal(uint8_t value) {
+    std::string digits = "0b";
+    for (int bit = 7; bit >= 0; bit--) {
+        digits += ((value >> bit) & 1) ? '1' : '0';
+    }
+    return digits;
+}
+
+// Body of one executeInstruction case (uses this->regs_ / this->pc_)
+void emit_step_case(std::ostream& out, uint8_t instruction) {
+    const sCPUMain::MicroOp op = sCPUMain::decode(instruction);
+    switch (op.kind) {
+        case sCPUMain::OP_LOAD:
+            out << "            this->regs_[" << (int)op.rd << "] = " << (int)op.imm << ";\n"
+                << "            written_reg = " << (int)op.rd << ";\n"
+                << "            written_value = " << (int)op.imm << ";\n"
+                << "            this->pc_ = (this->pc_ + 1) & PC_MASK;\n"
+                << "            return true;\n";
+            break;
+        case sCPUMain::OP_ADD:
+            out << "            written_value = this->regs_[" << (int)op.rs1 << "] + this->regs_[" << (int)op.rs2 << "];\n"
+                << "            this->regs_[" << (int)op.rd << "] = written_value;\n"
+                << "            written_reg = " << (int)op.rd << ";\n"
+                << "            this->pc_ = (this->pc_ + 1) & PC_MASK;\n"
+                << "            return true;\n";
+            break;
+        case sCPUMain::OP_BNER0:
+            out << "            if (this->regs_[" << (int)op.rs2 << "] != this->regs_[0]) {\n"
+                << "                this->pc_ = " << (int)op.target << ";\n"
+                << "            } else {\n"
+                << "                this->pc_ = (this->pc_ + 1) & PC_MASK;\n"
+                << "            }\n"
+                << "            return false;\n";
+            break;
+        default:
+            out << "            this->pc_ = (this->pc_ + 1) & PC_MASK;\n"
+                << "            return false;\n";
+            break;
+    }
+}
+
+// Write the specialized translation unit; program holds the whole ROM (ROM_SIZE words)
+void emit_program(std::ostream& out, const std::vector<uint8_t>& program, const std::string& source) {
+    const int size = program.size();
+    bool uses_halt = false;
+
+    out << "// Generated by scpu_compile from " << source << " -- do not edit.\n"
+        << "// sCPUCompiled golden model specialized for a " << size << "-instruction ROM image.\n\n"
+        << "#include <cstdint>\n"
+        << "#include <iostream>\n"
+        << "#include <vector>\n"
+        << "#include \"sCPUCompiled.h\"\n\n";
+
+    // ROM image (kept for fetchInstruction and the loadInstructions check)
+    out << "static const uint8_t kProgram[" << size << "] = {\n";
+    for (int pc = 0; pc < size; pc++) {
+        out << "    " << binary_literal(program[pc]) << (pc + 1 < size ? "," : " ")
+            << "  // " << pc << ": " << disassemble(program[pc]) << "\n";
+    }
+    out << "};\n\n";
+
+    out << R"(// Constructors
+sCPUCompiled::sCPUCompiled() {
+    this->pc_ = 0;
+    for (int i = 0; i < 4; ++i) {
+        this->regs_[i] = 0;
+    }
+}
+
+// Destructor
+sCPUCompiled::~sCPUCompiled() {
+
+}
+
+// Get/Set PC
+uint8_t sCPUCompiled::getPc() {
+    return this->pc_;
+}
+
+void sCPUCompiled::setPc(uint8_t pc) {
+    this->pc_ = pc & PC_MASK;
+}
+
+// Architectural state as one word (same layout as sCPUMain::getPackedState)
+uint64_t sCPUCompiled::getPackedState() {
+    return (uint64_t)this->pc_ | ((uint64_t)this->regs_[0] << 8) | ((uint64_t)this->regs_[1] << 16)
+         | ((uint64_t)this->regs_[2] << 24) | ((uint64_t)this->regs_[3] << 32);
+}
+
+// Get/Set register values
+uint8_t sCPUCompiled::getRegister(uint8_t register_index) {
+    if (register_index < 4) {
+        return this->regs_[register_index];
+    }
+    return 0;
+}
+
+void sCPUCompiled::setRegister(uint8_t register_index, uint8_t register_value) {
+    if (register_index < 4) {
+        this->regs_[register_index] = register_value;
+    }
+}
+
+uint8_t sCPUCompiled::fetchInstruction(uint8_t index) {
+    return kProgram[index & PC_MASK];
+}
+
+// The program is compiled in: only checks that bytes match the compiled image
+// (missing bytes read as 0x00, bytes past the ROM are dropped, as in sCPUMain)
+void sCPUCompiled::loadInstructions(const std::vector<uint8_t>& bytes) {
+    for (uint32_t i = 0; i <= PC_MASK; ++i) {
+        uint8_t expected = kProgram[i];
+        uint8_t actual = i < bytes.size() ? bytes[i] : 0;
+        if (expected != actual) {
+            std::cerr << "err sCPUCompiled: loaded program differs from the compiled image at address " << i << "\n";
+            return;
+        }
+    }
+}
+
+// Same halt rules as sCPUMain::isHalted
+bool sCPUCompiled::isHalted() {
+    return sCPUMain::haltsAt(decode(kProgram[this->pc_]), this->pc_, this->regs_);
+}
+
+)";
+
+    // Single step: one case per address
+    out << "// Execute one instruction at PC\n"
+        << "bool sCPUCompiled::executeInstruction(uint8_t& written_reg, uint8_t& written_value) {\n"
+        << "    switch (this->pc_) {\n";
+    for (int pc = 0; pc < size; pc++) {
+        out << "        case " << pc << ":  // " << disassemble(program[pc]) << "\n";
+        emit_step_case(out, program[pc]);
+    }
+    out << "    }\n"
+        << "    return false;\n"
+        << "}\n\n";
+
+    // Batched run: one label per address, branches are gotos, the last address falls
+    // through to L0 (PC 15 + 1 wraps to 0)
+    std::ostringstream body;
+    for (int pc = 0; pc < size; pc++) {
+        const sCPUMain::MicroOp op = sCPUMain::decode(program[pc]);
+        body << "L" << pc << ":  // " << disassemble(program[pc]) << "\n"
+             << "    if (retired == max_instructions) { pc = " << pc << "; goto stop_limit; }\n"
+             << "    retired++;\n";
+        switch (op.kind) {
+            case sCPUMain::OP_LOAD:
+                body << "    r" << (int)op.rd << " = " << (int)op.imm << ";\n";
+                break;
+            case sCPUMain::OP_ADD:
+                body << "    r" << (int)op.rd << " = r" << (int)op.rs1 << " + r" << (int)op.rs2 << ";\n";
+                break;
+            case sCPUMain::OP_BNER0:
+                if (op.rs2 == 0) {
+                    body << "    // r0 != r0 is never true: falls through\n";
+                } else if (op.target == pc) {
+                    uses_halt = true;
+                    body << "    if (r" << (int)op.rs2 << " != r0) { pc = " << pc << "; goto stop_halt; }\n";
+                } else {
+                    body << "    if (r" << (int)op.rs2 << " != r0) goto L" << (int)op.target << ";\n";
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    body << "    goto L0;\n";
+
+    out << "// Execute up to max_instructions (same stop rules as sCPUMain::run)\n"
+        << "sCPUCompiled::RunResult sCPUCompiled::run(uint64_t max_instructions) {\n"
+        << "    uint8_t pc = this->pc_;\n"
+        << "    uint8_t r0 = this->regs_[0];\n"
+        << "    uint8_t r1 = this->regs_[1];\n"
+        << "    uint8_t r2 = this->regs_[2];\n"
+        << "    uint8_t r3 = this->regs_[3];\n"
+        << "    uint64_t retired = 0;\n"
+        << "    StopReason stop_reason;\n\n"
+        << "    switch (pc & PC_MASK) {\n";
+    for (int pc = 0; pc < size; pc++) {
+        out << "        case " << pc << ": goto L" << pc << ";\n";
+    }
+    out << "    }\n\n";
+    out << body.str() << "\n"
+        << "stop_limit:\n"
+        << "    stop_reason = sCPUMain::STOP_LIMIT;\n";
+    if (uses_halt) {
+        out << "    goto done;\n"
+            << "stop_halt:\n"
+            << "    stop_reason = sCPUMain::STOP_HALT;\n"
+            << "done:\n";
+    }
+    out << R"(    this->pc_ = pc;
+    this->regs_[0] = r0;
+    this->regs_[1] = r1;
+    this->regs_[2] = r2;
+    this->regs_[3] = r3;
+
+    RunResult result;
+    result.retired = retired;
+    result.pc = pc;
+    for (int i = 0; i < 4; ++i) {
+        result.regs[i] = this->regs_[i];
+    }
+    result.stop_reason = stop_reason;
+    return result;
+}
+)";
+}
+
+int main(int argc, char** argv) {
+    bool raw = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--raw") {
+            raw = true;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--raw] <program> <output.cpp>\n";
+        return 1;
+    }
+
+    std::vector<uint8_t> program;
+    bool ok = raw ? read_raw_program(paths[0], program) : read_text_program(paths[0], program);
+    if (!ok) {
+        return 1;
+    }
+    if (program.size() > sCPUMain::ROM_SIZE) {
+        std::cout << "Program has " << program.size() << " bytes, only the first " << sCPUMain::ROM_SIZE
+                  << " are reachable by the " << sCPUMain::PC_WIDTH << "-bit PC\n";
+    }
+    program.resize(sCPUMain::ROM_SIZE);     // unused slots read 0x00
+
+    std::ofstream out(paths[1]);
+    if (!out) {
+        std::cerr << "err Cannot write " << paths[1] << "\n";
+        return 1;
+    }
+    emit_program(out, program, paths[0]);
+
+    std::cout << "ok Compiled " << program.size() << " instructions from " << paths[0] << " into " << paths[1] << "\n";
+    return 0;
+}
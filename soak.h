@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include "lockstep.h"
+
+// Soak mode: the designed and golden models run freely, each folding its packed state
+// (lockstep.h layout) into a rolling hash every cycle; the hashes are compared only every
+// `interval` cycles, where a light checkpoint of both models is kept. A hash mismatch means
+// some cycle of the last interval diverged: Soak then bisects between the last good
+// checkpoint and the bad compare point, re-simulating from checkpoints with hashes, until
+// the exact first divergent cycle is known, and reports both states of that cycle.
+//
+// Adapters are the lockstep ones (step / packedState / halted). Snapshots saves and
+// restores both models:
+//   typedef ... Snapshot;
+//   void save(uint64_t cycle, Snapshot&);
+//   void restore(const Snapshot&);
+// e.g. VerilatedSnapshots (checkpoint_verilated.h) for Vmain + a golden CPU.
+//
+// Equal hashes are taken as equal state sequences (a 64-bit collision is possible in
+// principle, not in practice).
+
+inline uint64_t soak_hash(uint64_t hash, uint64_t state) {
+    hash = (hash ^ state) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+const uint64_t SOAK_HASH_SEED = 0xCBF29CE484222325ull;
+
+struct SoakResult {
+    bool diverged;
+    bool halted;                // both models halted (no divergence)
+    uint64_t cycles;            // cycles run (up to the halt, the cap or the first divergent cycle)
+    uint64_t compares;          // hash compares at interval boundaries
+    uint64_t first_divergent;   // loop index of the first cycle whose states differ, as in lockstep
+    uint64_t designed_state;    // states after that cycle
+    uint64_t golden_state;
+    uint64_t resimulated;       // cycles re-run by the bisection
+};
+
+template <typename Designed, typename Golden, typename Snapshots>
+class Soak {
+    public:
+        typedef typename Snapshots::Snapshot Snapshot;
+
+        Soak(Designed& designed, Golden& golden, Snapshots& snapshots, uint64_t interval)
+            : designed_(designed), golden_(golden), snapshots_(snapshots),
+              interval_(interval > 0 ? interval : 1) {}
+
+        // Run from the current state (cycle first_cycle) for up to max_cycles cycles in total
+        SoakResult run(uint64_t max_cycles, uint64_t first_cycle = 0) {
+            SoakResult result = {};
+            uint64_t cycle = first_cycle;
+            this->snapshots_.save(cycle, this->good_);
+
+            while (cycle < max_cycles) {
+                uint64_t count = max_cycles - cycle < this->interval_ ? max_cycles - cycle : this->interval_;
+                uint64_t designed_hash = SOAK_HASH_SEED;
+                uint64_t golden_hash = SOAK_HASH_SEED;
+                bool halted = false;
+                uint64_t ran = runHashed(count, designed_hash, golden_hash, halted);
+                result.compares++;
+
+                if (designed_hash != golden_hash) {
+                    bisect(cycle, cycle + ran, result);
+                    return result;
+                }
+                cycle += ran;
+                if (halted) {
+                    result.halted = true;
+                    break;
+                }
+                this->snapshots_.save(cycle, this->good_);
+            }
+            result.cycles = cycle;
+            return result;
+        }
+
+        // Checkpoint of the last state known to match: after a divergence, the state right
+        // before the first divergent cycle (e.g. to write it out and re-run it with tracing)
+        const Snapshot& lastGood() const { return this->good_; }
+
+    private:
+        // Steps both models up to count cycles (stopping once both halt); returns the cycles run
+        uint64_t runHashed(uint64_t count, uint64_t& designed_hash, uint64_t& golden_hash, bool& halted) {
+            for (uint64_t i = 0; i < count; i++) {
+                this->designed_.step();
+                this->golden_.step();
+                designed_hash = soak_hash(designed_hash, this->designed_.packedState());
+                golden_hash = soak_hash(golden_hash, this->golden_.packedState());
+                if (this->designed_.halted() && this->golden_.halted()) {
+                    halted = true;
+                    return i + 1;
+                }
+            }
+            return count;
+        }
+
+        // good_ holds the state after cycle good (all states up to it matched); some state of
+        // cycles good+1..bad differs. Halve the range until it is a single cycle.
+        void bisect(uint64_t good, uint64_t bad, SoakResult& result) {
+            while (bad - good > 1) {
+                uint64_t middle = good + (bad - good) / 2;
+                this->snapshots_.restore(this->good_);
+                uint64_t designed_hash = SOAK_HASH_SEED;
+                uint64_t golden_hash = SOAK_HASH_SEED;
+                bool halted = false;
+                uint64_t ran = runHashed(middle - good, designed_hash, golden_hash, halted);
+                result.resimulated += ran;
+                if (designed_hash == golden_hash && ran == middle - good) {
+                    this->snapshots_.save(middle, this->good_);
+                    good = middle;
+                } else {
+                    bad = middle;
+                }
+            }
+
+            // Replay the divergent cycle for the detailed report
+            this->snapshots_.restore(this->good_);
+            this->designed_.step();
+            this->golden_.step();
+            result.resimulated++;
+            result.diverged = true;
+            result.cycles = bad;
+            result.first_divergent = bad - 1;
+            result.designed_state = this->designed_.packedState();
+            result.golden_state = this->golden_.packedState();
+        }
+
+        Designed& designed_;
+        Golden& golden_;
+        Snapshots& snapshots_;
+        uint64_t interval_;
+        Snapshot good_;     // last checkpoint known to be good
+};
@@ -0,0 +1,229 @@
+// Soak mode on two golden models, one with an injected fault: the hash compares must catch
+// the fault and the bisection must land on exactly the cycle lockstep reports.
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "checkpoint.h"
+#include "lockstep.h"
+#include "sCPU.h"
+#include "soak.h"
+
+// Endless loop (r1 counts up, r2 sums r1)
+const uint8_t LOOP[] = {
+    0b10001111,  // 0: li r0, 15
+    0b10110001,  // 1: li r3, 1
+    0b00010111,  // 2: add r1, r1, r3
+    0b00101001,  // 3: add r2, r2, r1
+    0b11001011   // 4: bner0 r3, 2
+};
+
+// Designed stand-in: sCPUMain that goes wrong after cycle fault_cycle (loop index), either
+// for good (R1 bit flipped) or for that one cycle only (reported state glitches)
+class FaultyAdapter {
+    public:
+        enum Fault { NONE, FLIP_R1, GLITCH };
+
+        FaultyAdapter(sCPUMain& cpu, Fault fault, uint64_t fault_cycle)
+            : cpu_(cpu), fault_(fault), fault_cycle_(fault_cycle), cycles_(0) {}
+
+        void step() {
+            uint8_t written_reg, written_value;
+            this->cpu_.executeInstruction(written_reg, written_value);
+            if (this->fault_ == FLIP_R1 && this->cycles_ == this->fault_cycle_) {
+                this->cpu_.setRegister(1, this->cpu_.getRegister(1) ^ 0x40);
+            }
+            this->cycles_++;
+        }
+
+        uint64_t packedState() {
+            uint64_t state = this->cpu_.getPackedState();
+            if (this->fault_ == GLITCH && this->cycles_ == this->fault_cycle_ + 1) {
+                state ^= 1ull << 36;    // R3 bit 4
+            }
+            return state;
+        }
+
+        bool halted() {
+            return this->cpu_.isHalted();
+        }
+
+        uint64_t cycles() const { return this->cycles_; }
+        void setCycles(uint64_t cycles) { this->cycles_ = cycles; }
+
+    private:
+        sCPUMain& cpu_;
+        Fault fault_;
+        uint64_t fault_cycle_;
+        uint64_t cycles_;
+};
+
+struct PairSnapshot {
+    Checkpoint designed;
+    Checkpoint golden;
+};
+
+class PairSnapshots {
+    public:
+        typedef PairSnapshot Snapshot;
+
+        PairSnapshots(FaultyAdapter& adapter, sCPUMain& designed, sCPUMain& golden)
+            : adapter_(adapter), designed_(designed), golden_(golden), saves_(0), restores_(0) {}
+
+        void save(uint64_t cycle, PairSnapshot& snapshot) {
+            save_golden(this->designed_, snapshot.designed);
+            save_golden(this->golden_, snapshot.golden);
+            snapshot.designed.cycle = cycle;
+            this->saves_++;
+        }
+
+        void restore(const PairSnapshot& snapshot) {
+            restore_golden(this->designed_, snapshot.designed);
+            restore_golden(this->golden_, snapshot.golden);
+            this->adapter_.setCycles(snapshot.designed.cycle);
+            this->restores_++;
+        }
+
+        int saves() const { return this->saves_; }
+        int restores() const { return this->restores_; }
+
+    private:
+        FaultyAdapter& adapter_;
+        sCPUMain& designed_;
+        sCPUMain& golden_;
+        int saves_;
+        int restores_;
+};
+
+// First mismatching loop index in plain lockstep, or -1
+int64_t lockstep_first_mismatch(const std::vector<uint8_t>& program, FaultyAdapter::Fault fault,
+                                uint64_t fault_cycle, uint64_t max_cycles) {
+    sCPUMain designed_cpu, golden_cpu;
+    designed_cpu.loadInstructions(program);
+    golden_cpu.loadInstructions(program);
+    FaultyAdapter designed(designed_cpu, fault, fault_cycle);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+    Lockstep<FaultyAdapter, GoldenAdapter<sCPUMain> > lockstep(designed, golden);
+    for (uint64_t cycle = 0; cycle < max_cycles; cycle++) {
+        if (!lockstep.step()) {
+            return cycle;
+        }
+        if (lockstep.halted()) {
+            break;
+        }
+    }
+    return -1;
+}
+
+struct SoakRun {
+    SoakResult result;
+    int saves;
+    int restores;
+};
+
+SoakRun soak(const std::vector<uint8_t>& program, FaultyAdapter::Fault fault, uint64_t fault_cycle,
+             uint64_t interval, uint64_t max_cycles) {
+    sCPUMain designed_cpu, golden_cpu;
+    designed_cpu.loadInstructions(program);
+    golden_cpu.loadInstructions(program);
+    FaultyAdapter designed(designed_cpu, fault, fault_cycle);
+    GoldenAdapter<sCPUMain> golden(golden_cpu);
+    PairSnapshots snapshots(designed, designed_cpu, golden_cpu);
+    Soak<FaultyAdapter, GoldenAdapter<sCPUMain>, PairSnapshots> engine(designed, golden, snapshots, interval);
+    SoakRun run;
+    run.result = engine.run(max_cycles);
+    run.saves = snapshots.saves();
+    run.restores = snapshots.restores();
+    return run;
+}
+
+int log2_ceil(uint64_t value) {
+    int bits = 0;
+    while ((1ull << bits) < value) {
+        bits++;
+    }
+    return bits;
+}
+
+int main() {
+    std::cout << "Testing soak mode (hash compares + bisection)\n";
+    std::cout << "=============================================\n\n";
+
+    std::vector<uint8_t> loop(LOOP, LOOP + sizeof(LOOP));
+
+    // Test 1: no fault, endless loop: runs to the cap with one compare per interval
+    std::cout << "Test 1: Fault-free run to the cycle cap\n";
+    SoakRun clean = soak(loop, FaultyAdapter::NONE, 0, 1000, 100000);
+    if (clean.result.diverged || clean.result.halted || clean.result.cycles != 100000
+        || clean.result.compares != 100 || clean.restores != 0) {
+        std::cerr << "  ✗ FAIL: diverged " << clean.result.diverged << ", " << clean.result.cycles
+                  << " cycles, " << clean.result.compares << " compares\n";
+        return 1;
+    }
+    std::cout << "  ✓ 100000 cycles, 100 compares, no bisection\n\n";
+
+    // Test 2: persistent fault, any interval: bisection finds the lockstep cycle
+    std::cout << "Test 2: Persistent fault located exactly for every interval\n";
+    const uint64_t intervals[] = { 1, 2, 7, 64, 1000, 4096 };
+    const uint64_t fault_cycles[] = { 0, 1, 63, 64, 999, 1000, 31337, 99998 };
+    int cases = 0;
+    for (uint64_t interval : intervals) {
+        for (uint64_t fault_cycle : fault_cycles) {
+            int64_t expected = lockstep_first_mismatch(loop, FaultyAdapter::FLIP_R1, fault_cycle, 100000);
+            SoakRun run = soak(loop, FaultyAdapter::FLIP_R1, fault_cycle, interval, 100000);
+            const SoakResult& result = run.result;
+            bool states_differ = result.designed_state != result.golden_state
+                              && packed_register(result.designed_state, 1) != packed_register(result.golden_state, 1);
+            if (!result.diverged || (int64_t)result.first_divergent != expected || !states_differ) {
+                std::cerr << "  ✗ FAIL: interval " << interval << ", fault after cycle " << fault_cycle
+                          << ": soak says " << (result.diverged ? (int64_t)result.first_divergent : -1)
+                          << ", lockstep " << expected << "\n";
+                return 1;
+            }
+            // Bisection cost: about one interval of re-simulation and log2(interval) restores
+            if (result.resimulated > interval + 1 || run.restores > log2_ceil(interval) + 1) {
+                std::cerr << "  ✗ FAIL: interval " << interval << ": " << result.resimulated << " cycles re-simulated, "
+                          << run.restores << " restores\n";
+                return 1;
+            }
+            cases++;
+        }
+    }
+    std::cout << "  ✓ " << cases << " interval / fault combinations match lockstep\n\n";
+
+    // Test 3: a one-cycle glitch between compare points still changes the rolling hash
+    std::cout << "Test 3: Transient divergence between compare points\n";
+    SoakRun glitch = soak(loop, FaultyAdapter::GLITCH, 5432, 1000, 100000);
+    if (!glitch.result.diverged || glitch.result.first_divergent != 5432
+        || glitch.result.designed_state != (glitch.result.golden_state ^ (1ull << 36))) {
+        std::cerr << "  ✗ FAIL: glitch after cycle 5432 not located ("
+                  << (glitch.result.diverged ? (int64_t)glitch.result.first_divergent : -1) << ")\n";
+        return 1;
+    }
+    std::cout << "  ✓ glitch in the interval 5000..5999 located at cycle 5432\n\n";
+
+    // Test 4: random programs (halting or not), faults at random cycles
+    std::cout << "Test 4: 2000 random programs with random faults\n";
+    std::mt19937 rng(22);
+    for (int p = 0; p < 2000; p++) {
+        std::vector<uint8_t> program(16);
+        for (uint8_t& instruction : program) {
+            instruction = rng() & 0xFF;
+        }
+        FaultyAdapter::Fault fault = rng() % 2 ? FaultyAdapter::FLIP_R1 : FaultyAdapter::GLITCH;
+        uint64_t fault_cycle = rng() % 300;
+        uint64_t interval = 1 + rng() % 100;
+        int64_t expected = lockstep_first_mismatch(program, fault, fault_cycle, 500);
+        SoakResult result = soak(program, fault, fault_cycle, interval, 500).result;
+        int64_t found = result.diverged ? (int64_t)result.first_divergent : -1;
+        if (found != expected) {
+            std::cerr << "  ✗ FAIL: program " << p << ": soak " << found << ", lockstep " << expected << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ same first divergent cycle (or none) as lockstep\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
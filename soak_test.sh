@@ -0,0 +1,2 @@
+g++ -O2 -std=c++17 soak_test.cpp sCPU.cpp checkpoint.cpp -o soak_test
+./soak_test
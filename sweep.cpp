@@ -0,0 +1,57 @@
+#include "sCPU.h"
+#include "sweep.h"
+
+SweepSpace sweep_space(uint8_t instruction, uint32_t stride) {
+    const sCPU::MicroOp op = sCPU::decode(instruction);
+    int candidates[7];
+    int count = 0;
+    if (op.kind == sCPU::OP_ADD) {
+        candidates[count++] = op.rs1;
+        candidates[count++] = op.rs2;
+    } else if (op.kind == sCPU::OP_BNER0) {
+        candidates[count++] = 0;
+        candidates[count++] = op.rs2;
+    }
+    if (op.kind == sCPU::OP_ADD || op.kind == sCPU::OP_LOAD) {
+        candidates[count++] = op.rd;
+    }
+    for (int r = 0; r < 4; r++) {
+        candidates[count++] = r;
+    }
+
+    SweepSpace space = {};
+    space.instruction = instruction;
+    space.registers[0] = candidates[0];
+    for (int i = 1; i < count; i++) {
+        if (candidates[i] != candidates[0]) {
+            space.registers[1] = candidates[i];
+            break;
+        }
+    }
+    space.stride = stride > 0 ? stride : 1;
+    space.values = (256 + space.stride - 1) / space.stride;
+    space.states = (uint64_t)SWEEP_PCS * space.values * space.values;
+    return space;
+}
+
+uint64_t sweep_state(const SweepSpace& space, uint64_t index) {
+    uint64_t digits = index / SWEEP_PCS;
+    uint8_t values[2] = {
+        (uint8_t)((digits % space.values) * space.stride),
+        (uint8_t)((digits / space.values) * space.stride)
+    };
+
+    uint64_t background = (index ^ ((uint64_t)space.instruction << 56)) * 0x9E3779B97F4A7C15ull;
+    background ^= background >> 29;
+    uint64_t state = index % SWEEP_PCS;
+    for (int r = 0; r < 4; r++) {
+        uint8_t value = (background >> (8 * r)) & 0xFF;
+        for (int i = 0; i < 2; i++) {
+            if (space.registers[i] == r) {
+                value = values[i];
+            }
+        }
+        state |= (uint64_t)value << (8 + 8 * r);
+    }
+    return state;
+}
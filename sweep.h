@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Exhaustive single-step equivalence sweep: for every 8-bit encoding, the designed and the
+// golden model are preset to each state of the encoding's sweep space, execute exactly one
+// instruction, and their packed states (lockstep.h layout) are compared.
+//
+// A sweep space covers all 16 PCs and all 256 x 256 values of two registers: the registers
+// the encoding reads (sISA semantics: ADD rs1 / rs2, BNER0 r0 / rs2), topped up with its
+// destination and then R0..R3. The other two registers take hashed background values, so
+// writes to the wrong register and reads of unrelated registers show up too. Since a
+// golden step depends only on the PC and the registers read, a clean sweep is a complete
+// per-instruction equivalence check over those inputs. stride > 1 samples every stride-th
+// register value (quick runs).
+//
+// Models are stepped in batches of preset states:
+//   void load(uint8_t instruction);     every ROM slot holds the encoding
+//   void step(const uint64_t* before, uint64_t* after, uint32_t count);
+// GoldenSweepModel wraps a golden CPU; the Verilated one is in sweep_rtl.cpp.
+
+const int SWEEP_PCS = 16;   // 4-bit PC of main.sv
+
+struct SweepSpace {
+    uint8_t instruction;
+    uint8_t registers[2];   // swept registers
+    uint32_t stride;
+    uint32_t values;        // values per swept register
+    uint64_t states;        // SWEEP_PCS * values^2
+};
+
+SweepSpace sweep_space(uint8_t instruction, uint32_t stride = 1);
+
+// Packed preset state number index of space: PC from the low digit, the swept registers
+// from the next two, the others from a hash of (instruction, index)
+uint64_t sweep_state(const SweepSpace& space, uint64_t index);
+
+// Outcome of one encoding; the counterexample is the lowest mismatching state index
+struct SweepResult {
+    uint8_t instruction;
+    uint64_t states;
+    uint64_t mismatches;
+    uint64_t first_index;
+    uint64_t before;            // preset state of the counterexample
+    uint64_t designed_state;    // states after its step
+    uint64_t golden_state;
+};
+
+// Golden single-step model on any CPU with the sCPUSized interface (sCPUMain)
+template <typename CPU>
+class GoldenSweepModel {
+    public:
+        void load(uint8_t instruction) {
+            uint8_t rom[SWEEP_PCS];
+            std::fill(rom, rom + SWEEP_PCS, instruction);
+            this->cpu_.loadInstructions(rom, SWEEP_PCS);
+        }
+
+        void step(const uint64_t* before, uint64_t* after, uint32_t count) {
+            for (uint32_t i = 0; i < count; i++) {
+                this->cpu_.setPc(before[i] & 0xFF);
+                for (int r = 0; r < 4; r++) {
+                    this->cpu_.setRegister(r, (before[i] >> (8 + 8 * r)) & 0xFF);
+                }
+                uint8_t written_reg, written_value;
+                this->cpu_.executeInstruction(written_reg, written_value);
+                after[i] = this->cpu_.getPackedState();
+            }
+        }
+
+    private:
+        CPU cpu_;
+};
+
+// Spreads the batches of all encodings over worker threads (one designed and one golden
+// model per worker, handed out through an atomic batch counter)
+template <typename Designed, typename Golden>
+class Sweep {
+    public:
+        Sweep(int threads, uint32_t batch_size, uint32_t stride)
+            : threads_(threads > 0 ? threads : 1), batch_size_(batch_size > 0 ? batch_size : 1),
+              stride_(stride > 0 ? stride : 1) {}
+
+        // make_designed() returns a std::unique_ptr<Designed>, called once per worker.
+        // One result per encoding, in order; identical for any thread count.
+        template <typename MakeDesigned>
+        std::vector<SweepResult> run(const std::vector<uint8_t>& encodings, MakeDesigned make_designed) {
+            std::vector<SweepSpace> spaces;
+            std::vector<uint64_t> first_batch(1, 0);    // batch numbering across encodings
+            for (uint8_t instruction : encodings) {
+                spaces.push_back(sweep_space(instruction, this->stride_));
+                uint64_t batches = (spaces.back().states + this->batch_size_ - 1) / this->batch_size_;
+                first_batch.push_back(first_batch.back() + batches);
+            }
+
+            std::vector<std::vector<SweepResult> > partial(this->threads_, empty(encodings));
+            std::atomic<uint64_t> next_batch(0);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < this->threads_; t++) {
+                workers.emplace_back([&, t]() {
+                    std::unique_ptr<Designed> designed = make_designed();
+                    Golden golden;
+                    runWorker(*designed, golden, spaces, first_batch, next_batch, partial[t]);
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+
+            std::vector<SweepResult> results = empty(encodings);
+            for (const std::vector<SweepResult>& worker_results : partial) {
+                for (size_t e = 0; e < results.size(); e++) {
+                    merge(results[e], worker_results[e]);
+                }
+            }
+            return results;
+        }
+
+    private:
+        static std::vector<SweepResult> empty(const std::vector<uint8_t>& encodings) {
+            std::vector<SweepResult> results(encodings.size(), SweepResult());
+            for (size_t e = 0; e < encodings.size(); e++) {
+                results[e].instruction = encodings[e];
+                results[e].first_index = UINT64_MAX;
+            }
+            return results;
+        }
+
+        static void merge(SweepResult& into, const SweepResult& from) {
+            into.states += from.states;
+            into.mismatches += from.mismatches;
+            if (from.first_index < into.first_index) {
+                into.first_index = from.first_index;
+                into.before = from.before;
+                into.designed_state = from.designed_state;
+                into.golden_state = from.golden_state;
+            }
+        }
+
+        void runWorker(Designed& designed, Golden& golden, const std::vector<SweepSpace>& spaces,
+                       const std::vector<uint64_t>& first_batch, std::atomic<uint64_t>& next_batch,
+                       std::vector<SweepResult>& results) {
+            std::vector<uint64_t> before(this->batch_size_);
+            std::vector<uint64_t> designed_after(this->batch_size_);
+            std::vector<uint64_t> golden_after(this->batch_size_);
+            size_t loaded = spaces.size();
+            for (;;) {
+                uint64_t batch = next_batch.fetch_add(1, std::memory_order_relaxed);
+                if (batch >= first_batch.back()) {
+                    return;
+                }
+                size_t e = std::upper_bound(first_batch.begin(), first_batch.end(), batch) - first_batch.begin() - 1;
+                const SweepSpace& space = spaces[e];
+                if (e != loaded) {
+                    designed.load(space.instruction);
+                    golden.load(space.instruction);
+                    loaded = e;
+                }
+
+                uint64_t first = (batch - first_batch[e]) * this->batch_size_;
+                uint32_t count = (uint32_t)std::min<uint64_t>(this->batch_size_, space.states - first);
+                for (uint32_t i = 0; i < count; i++) {
+                    before[i] = sweep_state(space, first + i);
+                }
+                designed.step(before.data(), designed_after.data(), count);
+                golden.step(before.data(), golden_after.data(), count);
+
+                SweepResult& result = results[e];
+                result.states += count;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (designed_after[i] == golden_after[i]) {
+                        continue;
+                    }
+                    result.mismatches++;
+                    if (first + i < result.first_index) {
+                        result.first_index = first + i;
+                        result.before = before[i];
+                        result.designed_state = designed_after[i];
+                        result.golden_state = golden_after[i];
+                    }
+                }
+            }
+        }
+
+        int threads_;
+        uint32_t batch_size_;
+        uint32_t stride_;
+};
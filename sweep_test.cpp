@@ -0,0 +1,145 @@
+// Single-step sweep engine on golden models: sCPUMain against itself, and against a
+// stand-in for main.sv that branches on r0 > rs2 (the RTL's BNER0) instead of rs2 != r0.
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+#include "lockstep.h"
+#include "sCPU.h"
+#include "sweep.h"
+
+// sCPUMain with the RTL's branch condition
+class GreaterBranchCPU : public sCPUMain {
+    public:
+        template <typename RegisterOut, typename DataOut>
+        bool executeInstruction(RegisterOut& written_reg, DataOut& written_value) {
+            MicroOp op = decode(fetchInstruction(getPc()));
+            if (op.kind == sCPU::OP_BNER0) {
+                setPc(getRegister(0) > getRegister(op.rs2) ? op.target : getPc() + 1);
+                return false;
+            }
+            return sCPUMain::executeInstruction(written_reg, written_value);
+        }
+};
+
+typedef GoldenSweepModel<sCPUMain> GoldenModel;
+typedef GoldenSweepModel<GreaterBranchCPU> FaultyModel;
+
+std::vector<uint8_t> all_encodings() {
+    std::vector<uint8_t> encodings;
+    for (int e = 0; e < 256; e++) {
+        encodings.push_back(e);
+    }
+    return encodings;
+}
+
+template <typename Designed>
+std::vector<SweepResult> run_sweep(int threads, uint32_t batch_size, uint32_t stride) {
+    Sweep<Designed, GoldenModel> sweep(threads, batch_size, stride);
+    return sweep.run(all_encodings(), []() { return std::unique_ptr<Designed>(new Designed); });
+}
+
+int main() {
+    std::cout << "Testing single-step equivalence sweep\n";
+    std::cout << "=====================================\n\n";
+
+    // Test 1: swept registers are the ones read, then the destination, then R0..R3
+    std::cout << "Test 1: Swept registers per encoding\n";
+    struct Expected { uint8_t instruction; int first; int second; };
+    const Expected expected[] = {
+        { 0x1B, 2, 3 },     // add r1, r2, r3
+        { 0x15, 1, 0 },     // add r1, r1, r1: destination r1, then r0
+        { 0x36, 1, 2 },     // add r3, r1, r2
+        { 0xC6, 0, 2 },     // bner0 r2, 1
+        { 0xC0, 0, 1 },     // bner0 r0, 0: reads r0 only
+        { 0xA5, 2, 0 },     // li r2, 5
+        { 0x7F, 0, 1 }      // nop
+    };
+    for (const Expected& e : expected) {
+        SweepSpace space = sweep_space(e.instruction);
+        if (space.registers[0] != e.first || space.registers[1] != e.second || space.states != 16 * 65536) {
+            std::cerr << "  ✗ FAIL: 0x" << std::hex << (int)e.instruction << std::dec << " sweeps r" << (int)space.registers[0]
+                      << ", r" << (int)space.registers[1] << " over " << space.states << " states\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ ADD rs1 / rs2, BNER0 r0 / rs2, LI rd, each over 16 PCs x 65536 values\n\n";
+
+    // Test 2: every (PC, value, value) of a space exactly once
+    std::cout << "Test 2: State enumeration is complete\n";
+    SweepSpace space = sweep_space(0x1B);
+    std::set<uint32_t> seen;
+    std::set<uint8_t> background;
+    for (uint64_t index = 0; index < space.states; index++) {
+        uint64_t state = sweep_state(space, index);
+        seen.insert((state & 0xFF) | ((state >> 16) & 0xFFFF00));   // PC, R2, R3
+        background.insert((state >> 8) & 0xFF);                     // R1
+    }
+    if (seen.size() != space.states || background.size() != 256) {
+        std::cerr << "  ✗ FAIL: " << seen.size() << " distinct swept states, " << background.size() << " R1 values\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << seen.size() << " distinct states, background R1 takes all 256 values\n\n";
+
+    // Test 3: the golden model against itself is equivalent everywhere
+    std::cout << "Test 3: Golden vs golden, all encodings (stride 4)\n";
+    std::vector<SweepResult> clean = run_sweep<GoldenModel>(4, 1000, 4);
+    uint64_t states = 0;
+    for (const SweepResult& result : clean) {
+        states += result.states;
+        if (result.mismatches != 0 || result.states != 16 * 64 * 64) {
+            std::cerr << "  ✗ FAIL: 0x" << std::hex << (int)result.instruction << std::dec << " " << result.mismatches
+                      << " mismatches in " << result.states << " states\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ " << states << " states, no mismatch\n\n";
+
+    // Test 4: the RTL-style branch differs exactly on the BNER0 encodings with rs2 != r0
+    std::cout << "Test 4: Finds the r0 > rs2 vs rs2 != r0 divergence\n";
+    std::vector<SweepResult> faulty = run_sweep<FaultyModel>(4, 1000, 1);
+    int failing = 0;
+    for (const SweepResult& result : faulty) {
+        bool expected_failure = (result.instruction >> 6) == sCPU::OP_BNER0 && (result.instruction & 0x3) != 0;
+        if ((result.mismatches > 0) != expected_failure) {
+            std::cerr << "  ✗ FAIL: 0x" << std::hex << (int)result.instruction << std::dec << " " << result.mismatches << " mismatches\n";
+            return 1;
+        }
+        if (result.mismatches == 0) {
+            continue;
+        }
+        failing++;
+        // r0 < rs2 is taken only in the golden model: 32640 such pairs, at the 15 PCs whose
+        // successor is not the branch target
+        uint8_t r0 = packed_register(result.before, 0);
+        uint8_t rs2 = packed_register(result.before, result.instruction & 0x3);
+        if (result.mismatches != 15 * 32640 || r0 >= rs2 || result.designed_state == result.golden_state) {
+            std::cerr << "  ✗ FAIL: 0x" << std::hex << (int)result.instruction << std::dec << " counterexample r0 " << (int)r0
+                      << ", rs2 " << (int)rs2 << ", " << result.mismatches << " mismatches\n";
+            return 1;
+        }
+    }
+    if (failing != 48) {
+        std::cerr << "  ✗ FAIL: " << failing << " failing encodings\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << failing << " BNER0 encodings, each " << faulty[0xC1].mismatches << " states with r0 < rs2\n\n";
+
+    // Test 5: results do not depend on the thread count or batch size
+    std::cout << "Test 5: 1 thread vs 8 threads\n";
+    std::vector<SweepResult> single = run_sweep<FaultyModel>(1, 4096, 4);
+    std::vector<SweepResult> parallel = run_sweep<FaultyModel>(8, 333, 4);
+    for (size_t e = 0; e < single.size(); e++) {
+        if (single[e].states != parallel[e].states || single[e].mismatches != parallel[e].mismatches
+            || single[e].first_index != parallel[e].first_index || single[e].before != parallel[e].before) {
+            std::cerr << "  ✗ FAIL: encoding " << e << " differs\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ identical counts and counterexamples\n\n";
+
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,21 @@
+g++ -O2 -std=c++17 -pthread sweep_test.cpp sweep.cpp sCPU.cpp -o sweep_test
+./sweep_test
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe sweep_rtl.cpp sweep.cpp campaign.cpp corpus.cpp coverage.cpp sCPU.cpp \
+  --trace \
+  -CFLAGS "-O2 -pthread" \
+  -LDFLAGS "-pthread"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lockstep.h"
+
+// Deferred waveform tracing: the model's full VCD trace (every signal Verilator traces:
+// ports, control unit, ALU, immediate extender, register file, ...) is captured in memory
+// (trace_ring_verilated.h), one value-change chunk per clock edge, and only the chunks of
+// the last N cycles are kept. Nothing is written until a trigger fires (explicit trigger()
+// e.g. on a lockstep mismatch, a packed state condition such as a PC value or register
+// value, or a cycle window); the VCD then holds the N cycles before the trigger and a few
+// cycles after it, starting with the value of every signal at its first edge.
+//
+// Signal names and widths are Verilator's declarations, so the ring follows the design
+// as it changes. Plugs into VerilatedAdapter as its Trace type (dump is called on both
+// clock edges).
+
+// Current value of every signal of a VCD value-change stream, by identifier code
+class VcdValues {
+    public:
+        // Apply one value-change line ("1!", "b0101 #", "r1.5 $"); other lines are ignored
+        void applyLine(const char* line, size_t size) {
+            if (size < 2 || line[0] == '#' || line[0] == '$') {
+                return;
+            }
+            if (line[0] == 'b' || line[0] == 'B' || line[0] == 'r' || line[0] == 'R') {
+                size_t space = size;
+                while (space > 0 && line[space - 1] != ' ') {
+                    space--;
+                }
+                if (space < 2) {
+                    return;
+                }
+                this->values_[std::string(line + space, size - space)].assign(line, space - 1);
+            } else {
+                this->values_[std::string(line + 1, size - 1)].assign(line, 1);
+            }
+        }
+
+        // Apply every line of text
+        void apply(const char* text, size_t size) {
+            const char* end = text + size;
+            while (text < end) {
+                const char* line_end = text;
+                while (line_end < end && *line_end != '\n') {
+                    line_end++;
+                }
+                applyLine(text, line_end - text);
+                text = line_end + 1;
+            }
+        }
+
+        // Every value as a value-change line
+        void write(std::string& out) const {
+            for (const auto& value : this->values_) {
+                out += value.second;
+                if (value.second.size() > 1) {
+                    out += ' ';
+                }
+                out += value.first;
+                out += '\n';
+            }
+        }
+
+        bool empty() const { return this->values_.empty(); }
+        void clear() { this->values_.clear(); }
+
+    private:
+        std::unordered_map<std::string, std::string> values_;
+};
+
+// Cuts the edges at times begin..end (exclusive) out of a VCD value-change body (the part
+// after $enddefinitions), fed in order in pieces of whole lines. Changes before the window
+// are folded into one $dumpvars block at its first edge, so every signal has a value from
+// there on; later $dumpvars blocks (snapshots of the same values) are dropped.
+class VcdWindow {
+    public:
+        VcdWindow(uint64_t begin, uint64_t end, const VcdValues& before = VcdValues())
+            : values_(before), begin_(begin), end_(end), opening_(false), opened_(false), done_(false),
+              in_dumpvars_(false), open_time_(0) {}
+
+        void add(const char* text, size_t size) {
+            const char* end = text + size;
+            while (text < end && !this->done_) {
+                const char* line_end = text;
+                while (line_end < end && *line_end != '\n') {
+                    line_end++;
+                }
+                addLine(text, line_end - text);
+                text = line_end + 1;
+            }
+        }
+        void add(const std::string& text) {
+            add(text.data(), text.size());
+        }
+
+        // The window (empty if no edge was in it)
+        const std::string& finish() {
+            open();
+            return this->text_;
+        }
+
+        bool done() const { return this->done_; }
+
+    private:
+        void addLine(const char* line, size_t size) {
+            if (size > 0 && line[0] == '#') {
+                uint64_t time = std::strtoull(line + 1, nullptr, 10);
+                if (time >= this->end_) {
+                    this->done_ = true;
+                    return;
+                }
+                if (this->opening_) {
+                    open();
+                }
+                if (!this->opened_ && time >= this->begin_) {
+                    // Values of the first edge are folded in before the window opens
+                    this->opening_ = true;
+                    this->open_time_ = time;
+                    return;
+                }
+            } else if (size >= 9 && std::strncmp(line, "$dumpvars", 9) == 0) {
+                this->in_dumpvars_ = true;
+                return;
+            } else if (size >= 4 && std::strncmp(line, "$end", 4) == 0) {
+                this->in_dumpvars_ = false;
+                return;
+            }
+            if (this->opened_) {
+                if (!this->in_dumpvars_ && (size == 0 || line[0] != '$')) {
+                    this->text_.append(line, size);
+                    this->text_ += '\n';
+                }
+            } else {
+                this->values_.applyLine(line, size);
+            }
+        }
+
+        void open() {
+            if (!this->opening_) {
+                return;
+            }
+            this->opening_ = false;
+            this->opened_ = true;
+            this->text_ += "#" + std::to_string(this->open_time_) + "\n$dumpvars\n";
+            this->values_.write(this->text_);
+            this->text_ += "$end\n";
+        }
+
+        VcdValues values_;
+        uint64_t begin_;
+        uint64_t end_;
+        bool opening_;          // first edge seen, its values still being folded in
+        bool opened_;
+        bool done_;
+        bool in_dumpvars_;
+        uint64_t open_time_;
+        std::string text_;
+};
+
+// Fires when (packed state & mask) == value, see lockstep.h for the layout
+struct TraceStateTrigger {
+    uint64_t mask;
+    uint64_t value;
+    std::string reason;
+};
+
+// The ring and its triggers, fed one clock edge of VCD text at a time (TraceRing in
+// trace_ring_verilated.h feeds it from a Verilated model)
+class VcdRing {
+    public:
+        // cycles: history kept before the trigger; post_cycles: cycles recorded after it
+        VcdRing(const std::string& path, uint64_t cycles, uint64_t post_cycles = 8)
+            : path_(path), edges_(2 * (cycles > 0 ? cycles : 1)),
+              next_(0), count_(0), post_edges_(2 * post_cycles), remaining_(0),
+              triggered_(false), written_(false), cycle_(0), window_begin_(~0ull), window_end_(0) {}
+
+        ~VcdRing() {
+            flush();
+        }
+
+        // VCD declarations of the traced signals (everything up to $enddefinitions)
+        void setDeclarations(const std::string& declarations) {
+            this->declarations_ = declarations;
+        }
+
+        // One clock edge: its value changes (starting with its #time line), then the clock
+        // and reset inputs and the packed state after it (for the triggers)
+        void addEdge(const char* changes, size_t size, bool clk, bool reset, uint64_t state) {
+            if (this->written_) {
+                return;
+            }
+
+            // The oldest edge leaves the ring: its changes become the values before the window
+            std::string& edge = this->edges_[this->next_];
+            if (this->count_ == this->edges_.size()) {
+                this->before_.apply(edge.data(), edge.size());
+            }
+            edge.assign(changes, size);
+            this->next_ = this->next_ + 1 == this->edges_.size() ? 0 : this->next_ + 1;
+            if (this->count_ < this->edges_.size()) {
+                this->count_++;
+            }
+
+            if (this->triggered_) {
+                if (--this->remaining_ == 0) {
+                    write();
+                }
+                return;
+            }
+
+            // Conditions are checked on the state after the rising edge
+            if (!clk || reset) {
+                return;
+            }
+            uint64_t cycle = this->cycle_++;
+            if (cycle == this->window_begin_) {
+                fire("cycle window " + std::to_string(this->window_begin_) + ".." + std::to_string(this->window_end_),
+                     2 * (this->window_end_ - this->window_begin_ - 1));
+                return;
+            }
+            for (const TraceStateTrigger& trigger : this->state_triggers_) {
+                if ((state & trigger.mask) == trigger.value) {
+                    fire(trigger.reason, this->post_edges_);
+                    return;
+                }
+            }
+        }
+
+        // False once the trace is written: further edges are not needed
+        bool recording() const { return !this->written_; }
+
+        // Fire now, e.g. on a lockstep mismatch; the trace is written post_cycles later
+        void trigger(const std::string& reason) {
+            if (!this->triggered_ && !this->written_) {
+                fire(reason, this->post_edges_);
+            }
+        }
+
+        // Trigger when the packed state matches (state & mask) == value
+        void addStateTrigger(uint64_t mask, uint64_t value, const std::string& reason) {
+            this->state_triggers_.push_back({ mask, value, reason });
+        }
+
+        void addPcTrigger(uint8_t pc) {
+            addStateTrigger(0xFF, pc, "PC " + std::to_string(pc));
+        }
+
+        void addRegisterTrigger(int index, uint8_t value) {
+            addStateTrigger(0xFFull << (8 + 8 * index), (uint64_t)value << (8 + 8 * index),
+                            "R" + std::to_string(index) + " == " + std::to_string(value));
+        }
+
+        // Record clock cycles begin..end (exclusive) plus the history before them; cycles
+        // count rising edges after reset, like the lockstep loop. Call before the run:
+        // the ring grows to hold the whole window.
+        void setCycleWindow(uint64_t begin, uint64_t end) {
+            this->window_begin_ = begin;
+            this->window_end_ = end > begin ? end : begin + 1;
+            size_t needed = this->edges_.size() + 2 * (this->window_end_ - this->window_begin_);
+            if (this->edges_.size() < needed && this->count_ == 0) {
+                this->edges_.resize(needed);
+            }
+        }
+
+        // Write a triggered trace whose post-trigger cycles did not all run (end of simulation)
+        void flush() {
+            if (this->triggered_ && !this->written_) {
+                write();
+            }
+        }
+
+        bool triggered() const { return this->triggered_; }
+        bool written() const { return this->written_; }
+        const std::string& reason() const { return this->reason_; }
+        const std::string& path() const { return this->path_; }
+
+    private:
+        void fire(const std::string& reason, uint64_t post_edges) {
+            this->triggered_ = true;
+            this->reason_ = reason;
+            this->remaining_ = post_edges;
+            // The post-trigger part must not push the trigger itself out of the ring
+            if (this->remaining_ >= this->edges_.size()) {
+                this->remaining_ = this->edges_.size() - 1;
+            }
+            if (this->remaining_ == 0) {
+                write();
+            }
+        }
+
+        // Ring contents, oldest edge first, as a VCD
+        void write() {
+            this->written_ = true;
+            VcdWindow window(0, ~0ull, this->before_);
+            size_t first = (this->next_ + this->edges_.size() - this->count_) % this->edges_.size();
+            for (size_t i = 0; i < this->count_; i++) {
+                window.add(this->edges_[(first + i) % this->edges_.size()]);
+            }
+            const std::string& body = window.finish();
+
+            FILE* file = std::fopen(this->path_.c_str(), "w");
+            if (file == nullptr) {
+                return;
+            }
+            std::fprintf(file, "$comment trigger: %s $end\n", this->reason_.c_str());
+            std::fwrite(this->declarations_.data(), 1, this->declarations_.size(), file);
+            std::fwrite(body.data(), 1, body.size(), file);
+            std::fclose(file);
+        }
+
+        std::string path_;
+        std::string declarations_;
+
+        // Ring of the last edges_.size() edges, next_ is the slot written next; before_
+        // holds the values from the edges already dropped
+        std::vector<std::string> edges_;
+        size_t next_;
+        size_t count_;
+        VcdValues before_;
+
+        // Edges still recorded after the trigger before the file is written
+        uint64_t post_edges_;
+        uint64_t remaining_;
+        bool triggered_;
+        bool written_;
+        std::string reason_;
+
+        // Rising edges seen since reset was released
+        uint64_t cycle_;
+
+        std::vector<TraceStateTrigger> state_triggers_;
+        uint64_t window_begin_;
+        uint64_t window_end_;
+};
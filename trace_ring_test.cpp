@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "trace_ring.h"
+
+// Stand-in for a Verilated model and its VCD trace: the "CPU" counts R0 up by one per
+// rising edge and runs PC through 0..15; an internal ALU output is traced too. dump()
+// returns the value changes of an edge like VerilatedVcdC (every value on the first dump).
+struct FakeModel {
+    uint8_t clk = 0;
+    uint8_t reset = 0;
+    uint64_t cycle = 0;
+    uint64_t dumped[5] = {};
+    bool first = true;
+
+    static const char* declarations() {
+        return "$timescale 1ps $end\n"
+               "$scope module TOP $end\n"
+               " $var wire 1 ! clk $end\n"
+               " $var wire 1 \" reset $end\n"
+               " $var wire 4 # pc_debug [3:0] $end\n"
+               " $var wire 8 $ reg0_debug [7:0] $end\n"
+               " $scope module main $end\n"
+               "  $scope module alu_inst $end\n"
+               "   $var wire 8 % result [7:0] $end\n"
+               "  $upscope $end\n"
+               " $upscope $end\n"
+               "$upscope $end\n"
+               "$enddefinitions $end\n";
+    }
+
+    void eval() {
+        if (clk && !reset) {
+            cycle++;
+        }
+    }
+
+    uint64_t state() const {
+        uint8_t regs[4] = { (uint8_t)cycle, 0, 0, 0 };
+        return pack_state(cycle & 0xF, regs);
+    }
+
+    std::string dump(uint64_t time) {
+        const uint64_t values[5] = { clk, reset, cycle & 0xF, cycle & 0xFF, (cycle + 1) & 0xFF };
+        const int widths[5] = { 1, 1, 4, 8, 8 };
+        const char* ids[5] = { "!", "\"", "#", "$", "%" };
+        std::string text = "#" + std::to_string(time) + "\n";
+        for (int s = 0; s < 5; s++) {
+            if (!first && values[s] == dumped[s]) {
+                continue;
+            }
+            if (widths[s] == 1) {
+                text += std::to_string(values[s]) + ids[s] + "\n";
+            } else {
+                text += "b";
+                for (int bit = widths[s] - 1; bit >= 0; bit--) {
+                    text += '0' + ((values[s] >> bit) & 1);
+                }
+                text += std::string(" ") + ids[s] + "\n";
+            }
+            dumped[s] = values[s];
+        }
+        first = false;
+        return text;
+    }
+};
+
+// Same clocking as VerilatedAdapter::clock, for reset_cycles + cycles cycles
+void run(FakeModel& model, VcdRing& ring, int reset_cycles, int cycles) {
+    ring.setDeclarations(FakeModel::declarations());
+    uint64_t time = 0;
+    for (int c = 0; c < reset_cycles + cycles; c++) {
+        model.reset = c < reset_cycles;
+        for (int clk = 0; clk < 2; clk++) {
+            model.clk = clk;
+            model.eval();
+            std::string changes = model.dump(time++);
+            ring.addEdge(changes.data(), changes.size(), model.clk, model.reset, model.state());
+        }
+    }
+}
+
+std::string read_file(const char* path) {
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+int main() {
+    std::cout << "Testing deferred ring-buffered waveform tracing\n";
+    std::cout << "===============================================\n\n";
+
+    const char* path = "trace_ring_test.vcd";
+
+    // Test 1: no trigger, no file
+    std::cout << "Test 1: Untriggered run writes nothing\n";
+    std::remove(path);
+    {
+        FakeModel model;
+        VcdRing ring(path, 16);
+        ring.addPcTrigger(200);
+        run(model, ring, 2, 100000);
+        if (ring.triggered() || std::ifstream(path).good()) {
+            std::cerr << "  ✗ FAIL: trace written without a trigger\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ No waveform file\n\n";
+
+    // Test 2: register trigger keeps the history before it and post cycles after it
+    std::cout << "Test 2: Register trigger\n";
+    {
+        FakeModel model;
+        VcdRing ring(path, 16, 4);
+        ring.addRegisterTrigger(0, 100);
+        run(model, ring, 2, 1000);
+        std::string vcd = read_file(path);
+        // R0 reaches 100 on the rising edge of post-reset cycle 99 (edge 2 * (2 + 99) + 1)
+        bool ok = ring.written() && ring.reason() == "R0 == 100"
+               && vcd.find("$var wire 8 % result [7:0] $end") != std::string::npos  // internal signal
+               && vcd.find("#180\n$dumpvars\n") != std::string::npos     // oldest kept edge (32 edges),
+               && vcd.find("\n0\"\n") < vcd.find("$end\n#181\n")          // with reset (changed at edge 4)
+               && vcd.find("#203\n") != std::string::npos          // trigger edge
+               && vcd.find("#211\n") != std::string::npos          // last post-trigger edge
+               && vcd.find("#212\n") == std::string::npos
+               && vcd.find("#179\n") == std::string::npos
+               && vcd.find("b01100100 $") != std::string::npos;    // R0 = 100
+        if (!ok) {
+            std::cerr << "  ✗ FAIL: unexpected trace (" << ring.reason() << ")\n" << vcd;
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Last 16 cycles before and 4 cycles after R0 == 100\n\n";
+
+    // Test 3: explicit trigger (mismatch) flushed at the end of the run
+    std::cout << "Test 3: Explicit trigger flushed on destruction\n";
+    std::remove(path);
+    {
+        FakeModel model;
+        VcdRing ring(path, 8, 100);
+        run(model, ring, 2, 50);
+        ring.trigger("mismatch");
+    }
+    if (read_file(path).find("$comment trigger: mismatch $end") == std::string::npos) {
+        std::cerr << "  ✗ FAIL: triggered trace not flushed\n";
+        return 1;
+    }
+    std::cout << "  ✓ Trace written\n\n";
+
+    // Test 4: cycle window larger than the history
+    std::cout << "Test 4: Cycle window\n";
+    {
+        FakeModel model;
+        VcdRing ring(path, 4);
+        ring.setCycleWindow(500, 600);
+        run(model, ring, 2, 1000);
+        std::string vcd = read_file(path);
+        // Edges of post-reset cycles 496..599
+        bool ok = ring.written()
+               && vcd.find("#" + std::to_string(2 * (2 + 496)) + "\n") != std::string::npos
+               && vcd.find("#" + std::to_string(2 * (2 + 600)) + "\n") == std::string::npos
+               && vcd.find("#" + std::to_string(2 * (2 + 599) + 1) + "\n") != std::string::npos;
+        if (!ok) {
+            std::cerr << "  ✗ FAIL: window not covered\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ Window 500..600 written\n\n";
+
+    std::remove(path);
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
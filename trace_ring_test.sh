@@ -0,0 +1,20 @@
+g++ -O2 -std=c++17 trace_ring_test.cpp -o trace_ring_test
+./trace_ring_test
+
+# Deferred tracing in the CPU testbench: waveform_cpu.vcd is only written when a trigger fires
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe main_test.cpp sCPU.cpp trace_store.cpp checkpoint.cpp \
+  --trace --savable
+
+make -C obj_dir -f Vmain.mk
+
+./obj_dir/Vmain --trace-ring=16 --trigger-reg=2:55
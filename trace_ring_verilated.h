@@ -0,0 +1,86 @@
+#pragma once
+
+#include <sys/types.h>
+#include <cstdint>
+#include <string>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "trace_ring.h"
+
+// Verilator-specific part of the deferred trace (trace_ring.h): the model's own VCD trace
+// captured in memory. The model must be built with --trace.
+
+// VerilatedVcdC output that appends to a string instead of writing a file
+class VcdMemoryFile : public VerilatedVcdFile {
+    public:
+        explicit VcdMemoryFile(std::string& text) : text_(text) {}
+
+        bool open(const std::string&) override { return true; }
+        void close() override {}
+        ssize_t write(const char* bufp, ssize_t len) override {
+            this->text_.append(bufp, len);
+            return len;
+        }
+
+    private:
+        std::string& text_;
+};
+
+// Verilator's trace of every traced signal of a model, as VCD text: the declarations once,
+// then the value changes of each dump (the first dump has every value)
+template <typename VModel>
+class VcdCapture {
+    public:
+        explicit VcdCapture(VModel& model) : file_(text_), vcd_(&file_) {
+            model.contextp()->traceEverOn(true);
+            model.trace(&this->vcd_, 99);
+            this->vcd_.open("memory");      // name unused, VcdMemoryFile keeps the text
+            this->vcd_.flush();
+            this->declarations_.swap(this->text_);
+        }
+
+        ~VcdCapture() {
+            this->vcd_.close();
+        }
+
+        const std::string& declarations() const {
+            return this->declarations_;
+        }
+
+        // Value changes since the last dump, starting with the #time line
+        const std::string& dump(uint64_t time) {
+            this->text_.clear();
+            this->vcd_.dump(time);
+            this->vcd_.flush();
+            return this->text_;
+        }
+
+    private:
+        std::string declarations_;
+        std::string text_;
+        VcdMemoryFile file_;
+        VerilatedVcdC vcd_;
+};
+
+// VcdRing fed from a Verilated model with main.sv's debug ports (state_debug for the triggers)
+template <typename VModel>
+class TraceRing : public VcdRing {
+    public:
+        TraceRing(VModel& model, const std::string& path, uint64_t cycles, uint64_t post_cycles = 8)
+            : VcdRing(path, cycles, post_cycles), model_(model), capture_(model) {
+            setDeclarations(this->capture_.declarations());
+        }
+
+        // Called by VerilatedAdapter after each clock edge (time counts edges, 2 per cycle)
+        void dump(uint64_t time) {
+            if (!recording()) {
+                return;
+            }
+            const std::string& changes = this->capture_.dump(time);
+            addEdge(changes.data(), changes.size(), this->model_.clk, this->model_.reset, this->model_.state_debug);
+        }
+
+    private:
+        VModel& model_;
+        VcdCapture<VModel> capture_;
+};
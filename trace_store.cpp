@@ -0,0 +1,242 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "trace_store.h"
+
+// ========== TraceStoreWriter ==========
+
+TraceStoreWriter::TraceStoreWriter() {
+    this->file_ = nullptr;
+    std::memset(&this->header_, 0, sizeof(this->header_));
+    this->offset_ = 0;
+    this->chunk_first_cycle_ = 0;
+    this->chunk_cycles_done_ = 0;
+}
+
+TraceStoreWriter::~TraceStoreWriter() {
+    close();
+}
+
+bool TraceStoreWriter::open(const std::string& path, const std::string& declarations, uint32_t chunk_cycles) {
+    close();
+
+    std::memset(&this->header_, 0, sizeof(this->header_));
+    std::memcpy(this->header_.magic, TRACE_STORE_MAGIC, sizeof(TRACE_STORE_MAGIC));
+    this->header_.version = TRACE_STORE_VERSION;
+    this->header_.chunk_cycles = chunk_cycles > 0 ? chunk_cycles : 1;
+    this->header_.declarations_size = declarations.size();
+    this->chunks_.clear();
+    this->buffer_.clear();
+    this->chunk_cycles_done_ = 0;
+    this->values_.clear();
+
+    this->file_ = std::fopen(path.c_str(), "wb");
+    if (this->file_ == nullptr) {
+        std::cerr << "err Cannot create " << path << "\n";
+        return false;
+    }
+    // Placeholder, rewritten with the final counts by close()
+    this->offset_ = sizeof(this->header_) + declarations.size();
+    return std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1
+        && std::fwrite(declarations.data(), 1, declarations.size(), this->file_) == declarations.size();
+}
+
+bool TraceStoreWriter::append(uint64_t cycle, const char* changes, size_t size) {
+    if (this->file_ == nullptr) {
+        return false;
+    }
+    if (this->header_.cycle_count == 0) {
+        this->header_.first_cycle = cycle;
+        this->chunk_first_cycle_ = cycle;
+    } else if (cycle != this->header_.first_cycle + this->header_.cycle_count) {
+        return false;   // cycles must be contiguous
+    }
+
+    // A chunk starts with every value so far, so it reads on its own
+    if (this->chunk_cycles_done_ == 0 && !this->values_.empty()) {
+        this->buffer_ += "$dumpvars\n";
+        this->values_.write(this->buffer_);
+        this->buffer_ += "$end\n";
+    }
+    this->buffer_.append(changes, size);
+    this->values_.apply(changes, size);
+    this->header_.cycle_count++;
+
+    if (++this->chunk_cycles_done_ == this->header_.chunk_cycles) {
+        return flushChunk();
+    }
+    return true;
+}
+
+bool TraceStoreWriter::flushChunk() {
+    if (this->chunk_cycles_done_ == 0) {
+        return true;
+    }
+
+    TraceStoreChunk chunk;
+    chunk.first_cycle = this->chunk_first_cycle_;
+    chunk.offset = this->offset_;
+    chunk.size = this->buffer_.size();
+    chunk.cycles = this->chunk_cycles_done_;
+    this->chunks_.push_back(chunk);
+
+    bool ok = std::fwrite(this->buffer_.data(), this->buffer_.size(), 1, this->file_) == 1;
+    this->offset_ += this->buffer_.size();
+    this->buffer_.clear();
+
+    this->chunk_first_cycle_ += this->chunk_cycles_done_;
+    this->chunk_cycles_done_ = 0;
+    return ok;
+}
+
+bool TraceStoreWriter::close() {
+    if (this->file_ == nullptr) {
+        return true;
+    }
+
+    bool ok = flushChunk();
+    this->header_.chunk_count = this->chunks_.size();
+    this->header_.index_offset = this->offset_;
+    ok = ok && (this->chunks_.empty()
+                || std::fwrite(this->chunks_.data(), sizeof(TraceStoreChunk), this->chunks_.size(), this->file_)
+                   == this->chunks_.size());
+    ok = ok && std::fseek(this->file_, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&this->header_, sizeof(this->header_), 1, this->file_) == 1;
+    ok = (std::fclose(this->file_) == 0) && ok;
+    this->file_ = nullptr;
+    return ok;
+}
+
+// ========== TraceStoreReader ==========
+
+TraceStoreReader::TraceStoreReader() {
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+}
+
+TraceStoreReader::~TraceStoreReader() {
+    close();
+}
+
+bool TraceStoreReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "err Cannot open " << path << "\n";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(TraceStoreHeader)) {
+        std::cerr << "err " << path << " is too small to be a trace store\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "err Cannot map " << path << "\n";
+        return false;
+    }
+    // Seeks touch a few chunks anywhere in the file
+    madvise(mapping, info.st_size, MADV_RANDOM);
+
+    const TraceStoreHeader* header = static_cast<const TraceStoreHeader*>(mapping);
+    bool valid = std::memcmp(header->magic, TRACE_STORE_MAGIC, sizeof(TRACE_STORE_MAGIC)) == 0
+              && header->version == TRACE_STORE_VERSION
+              && header->chunk_cycles > 0
+              && header->declarations_size <= (uint64_t)info.st_size - sizeof(TraceStoreHeader)
+              && header->index_offset >= sizeof(TraceStoreHeader) + header->declarations_size
+              && header->index_offset <= (uint64_t)info.st_size
+              && (info.st_size - header->index_offset) / sizeof(TraceStoreChunk) == header->chunk_count
+              && header->chunk_count == header->cycle_count / header->chunk_cycles
+                                        + (header->cycle_count % header->chunk_cycles != 0);
+
+    // read() addresses chunk (cycle - first_cycle) / chunk_cycles directly, so every chunk
+    // must cover exactly its slot of cycles and lie between the declarations and the index
+    const TraceStoreChunk* chunks = reinterpret_cast<const TraceStoreChunk*>(
+        static_cast<const uint8_t*>(mapping) + header->index_offset);
+    for (uint64_t k = 0; valid && k < header->chunk_count; k++) {
+        TraceStoreChunk chunk;
+        std::memcpy(&chunk, &chunks[k], sizeof(chunk));
+        uint64_t slot_first = k * header->chunk_cycles;
+        valid = chunk.first_cycle == header->first_cycle + slot_first
+             && chunk.cycles == std::min<uint64_t>(header->chunk_cycles, header->cycle_count - slot_first)
+             && chunk.offset >= sizeof(TraceStoreHeader) + header->declarations_size
+             && chunk.offset <= header->index_offset
+             && chunk.size <= header->index_offset - chunk.offset;
+    }
+    if (!valid) {
+        std::cerr << "err " << path << " is not a valid trace store (version " << TRACE_STORE_VERSION << ")\n";
+        munmap(mapping, info.st_size);
+        return false;
+    }
+
+    this->mapping_ = mapping;
+    this->mapping_size_ = info.st_size;
+    this->header_ = header;
+    this->chunks_.resize(header->chunk_count);
+    if (!this->chunks_.empty()) {
+        std::memcpy(this->chunks_.data(), static_cast<const uint8_t*>(mapping) + header->index_offset,
+                    this->chunks_.size() * sizeof(TraceStoreChunk));
+    }
+    return true;
+}
+
+void TraceStoreReader::close() {
+    if (this->mapping_ != nullptr) {
+        munmap(this->mapping_, this->mapping_size_);
+    }
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    this->header_ = nullptr;
+    this->chunks_.clear();
+}
+
+uint64_t TraceStoreReader::firstCycle() const {
+    return this->header_ != nullptr ? this->header_->first_cycle : 0;
+}
+
+uint64_t TraceStoreReader::cycleCount() const {
+    return this->header_ != nullptr ? this->header_->cycle_count : 0;
+}
+
+uint64_t TraceStoreReader::chunkCount() const {
+    return this->chunks_.size();
+}
+
+bool TraceStoreReader::readVcd(uint64_t begin, uint64_t end, std::string& vcd) {
+    vcd.clear();
+    if (this->header_ == nullptr) {
+        return false;
+    }
+    uint64_t first = this->header_->first_cycle;
+    begin = std::max(begin, first);
+    end = std::min(end, first + this->header_->cycle_count);
+    if (begin >= end) {
+        return true;
+    }
+
+    // Chunks have a fixed number of cycles, so the index is addressed directly; the chunk's
+    // snapshot and its edges before begin give the values at the window's first edge
+    const char* base = static_cast<const char*>(this->mapping_);
+    uint64_t chunk = (begin - first) / this->header_->chunk_cycles;
+    uint64_t last_chunk = (end - 1 - first) / this->header_->chunk_cycles;
+    VcdWindow window(2 * begin, 2 * end);
+    for (; chunk <= last_chunk && !window.done(); chunk++) {
+        window.add(base + this->chunks_[chunk].offset, this->chunks_[chunk].size);
+    }
+    vcd.assign(base + sizeof(TraceStoreHeader), this->header_->declarations_size);
+    vcd += window.finish();
+    return true;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "trace_ring.h"
+
+// Seekable store of a whole run's Verilator trace: the value changes of every traced signal
+// (VCD text captured in memory, see trace_ring_verilated.h), grouped in chunks of a fixed
+// number of cycles that read independently, with a cycle-to-chunk index at the end.
+// Reading cycles B..E reads only the chunks covering them, whatever the run length.
+//
+// Cycle n is the clock cycle at edges 2n (falling) and 2n+1 (rising) of VerilatedAdapter,
+// as in waveform_cpu.vcd; reset cycles included.
+//
+// File layout (little-endian):
+//   TraceStoreHeader (64 bytes)
+//   VCD declarations (declarations_size bytes, up to $enddefinitions)
+//   chunks, VCD value-change text:
+//     "$dumpvars" block with every value before the chunk (none in the first chunk, whose
+//     first edge is Verilator's full dump), then each edge's #time line and changes
+//   TraceStoreChunk index, one per chunk, up to the end of the file
+// VCD changes are already a delta encoding: a cycle costs its two time lines plus one line
+// per signal that changed.
+
+const char TRACE_STORE_MAGIC[8] = { 's', 'I', 'S', 'A', 'T', 'R', 'C', 'E' };
+const uint32_t TRACE_STORE_VERSION = 2;
+
+struct TraceStoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunk_cycles;      // cycles per chunk (the last one may be shorter)
+    uint64_t first_cycle;
+    uint64_t cycle_count;
+    uint64_t chunk_count;
+    uint64_t index_offset;      // file offset of the chunk index
+    uint64_t declarations_size; // VCD declarations right after the header
+    uint64_t reserved;
+};
+static_assert(sizeof(TraceStoreHeader) == 64, "trace store header must stay 64 bytes");
+
+struct TraceStoreChunk {
+    uint64_t first_cycle;
+    uint64_t offset;            // file offset of the chunk text
+    uint32_t size;              // text bytes
+    uint32_t cycles;
+};
+static_assert(sizeof(TraceStoreChunk) == 24, "trace store chunk entry must stay 24 bytes");
+
+class TraceStoreWriter {
+    public:
+        TraceStoreWriter();
+        ~TraceStoreWriter();
+
+        // declarations: Verilator's VCD header of the traced signals
+        bool open(const std::string& path, const std::string& declarations, uint32_t chunk_cycles = 4096);
+
+        // VCD value changes of the next cycle's two edges, each starting with its #time line
+        // (the first call sets the first cycle number)
+        bool append(uint64_t cycle, const char* changes, size_t size);
+
+        // Writes the last chunk, the index and the final header
+        bool close();
+
+        uint64_t cycleCount() const { return this->header_.cycle_count; }
+
+    private:
+        bool flushChunk();
+
+        FILE* file_;
+        TraceStoreHeader header_;
+        std::vector<TraceStoreChunk> chunks_;
+        uint64_t offset_;
+
+        // Chunk being written
+        std::string buffer_;
+        uint64_t chunk_first_cycle_;
+        uint32_t chunk_cycles_done_;
+
+        // Every signal's value after the cycles appended so far, for the next chunk's snapshot
+        VcdValues values_;
+};
+
+// Reads a trace store through mmap
+class TraceStoreReader {
+    public:
+        TraceStoreReader();
+        ~TraceStoreReader();
+
+        bool open(const std::string& path);
+        void close();
+
+        uint64_t firstCycle() const;
+        uint64_t cycleCount() const;
+        uint64_t chunkCount() const;
+
+        // Cycles begin..end (exclusive, clamped to the stored cycles) as a VCD: the
+        // declarations, every value at the first edge, then the value changes. Reads only
+        // the chunks covering them; empty if no stored cycle is in the window.
+        bool readVcd(uint64_t begin, uint64_t end, std::string& vcd);
+
+    private:
+        void* mapping_;
+        size_t mapping_size_;
+        const TraceStoreHeader* header_;
+        std::vector<TraceStoreChunk> chunks_;
+};
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lockstep.h"
+#include "sCPU.h"
+#include "trace_store.h"
+
+// Stand-in for Verilator's VCD trace of main.sv: clock, reset, the packed state port and an
+// internal ALU output. dump() returns the value changes of an edge like VerilatedVcdC (every
+// value on the first dump).
+struct FakeTrace {
+    static const int SIGNALS = 4;
+    uint64_t dumped[SIGNALS] = {};
+    bool first = true;
+
+    static const char* declarations() {
+        return "$timescale 1ps $end\n"
+               "$scope module TOP $end\n"
+               " $var wire 1 ! clk $end\n"
+               " $var wire 1 \" reset $end\n"
+               " $var wire 40 # state_debug [39:0] $end\n"
+               " $scope module main $end\n"
+               "  $scope module alu_inst $end\n"
+               "   $var wire 8 $ result [7:0] $end\n"
+               "  $upscope $end\n"
+               " $upscope $end\n"
+               "$upscope $end\n"
+               "$enddefinitions $end\n";
+    }
+
+    static std::string value(int signal, uint64_t value) {
+        const int widths[SIGNALS] = { 1, 1, 40, 8 };
+        const char* ids[SIGNALS] = { "!", "\"", "#", "$" };
+        if (widths[signal] == 1) {
+            return std::to_string(value) + ids[signal];
+        }
+        std::string text = "b";
+        for (int bit = widths[signal] - 1; bit >= 0; bit--) {
+            text += '0' + ((value >> bit) & 1);
+        }
+        return text + " " + ids[signal];
+    }
+
+    void dump(uint64_t time, const uint64_t (&values)[SIGNALS], std::string& text) {
+        text += "#" + std::to_string(time) + "\n";
+        for (int s = 0; s < SIGNALS; s++) {
+            if (first || values[s] != dumped[s]) {
+                text += value(s, values[s]) + "\n";
+            }
+            dumped[s] = values[s];
+        }
+        first = false;
+    }
+};
+
+// Per-cycle sample of the fake signals after the rising edge:
+//   bits 39:0 state, bits 47:40 ALU result, bit 48 reset
+// The falling edge of a cycle still shows the previous cycle's state and result.
+void edge_values(const std::vector<uint64_t>& samples, size_t index, bool clk, uint64_t (&values)[FakeTrace::SIGNALS]) {
+    uint64_t word = clk ? samples[index] : index > 0 ? samples[index - 1] : 0;
+    values[0] = clk;
+    values[1] = (samples[index] >> 48) & 1;   // reset is an input, already applied at the falling edge
+    values[2] = word & 0xFFFFFFFFFFull;
+    values[3] = (word >> 40) & 0xFF;
+}
+
+// Replays a window VCD edge by edge and checks every signal against the samples
+bool check_window(const std::string& vcd, uint64_t begin, uint64_t end, uint64_t first_cycle,
+                  const std::vector<uint64_t>& samples) {
+    std::string declarations = FakeTrace::declarations();
+    if (vcd.compare(0, declarations.size(), declarations) != 0) {
+        return false;
+    }
+    std::unordered_map<std::string, std::string> current;
+    uint64_t edges = 0;
+    auto check_edge = [&]() {
+        uint64_t time = 2 * begin + edges - 1;
+        uint64_t values[FakeTrace::SIGNALS];
+        edge_values(samples, time / 2 - first_cycle, time & 1, values);
+        if (current.size() != FakeTrace::SIGNALS) {
+            return false;
+        }
+        for (int s = 0; s < FakeTrace::SIGNALS; s++) {
+            std::string line = FakeTrace::value(s, values[s]);
+            size_t split = line.size() - 1;
+            if (current[line.substr(split)] != line.substr(0, line[0] == 'b' ? split - 1 : split)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    size_t position = declarations.size();
+    while (position < vcd.size()) {
+        size_t line_end = vcd.find('\n', position);
+        std::string line = vcd.substr(position, line_end - position);
+        position = line_end + 1;
+        if (line[0] == '#') {
+            if (edges > 0 && !check_edge()) {
+                return false;
+            }
+            if (std::stoull(line.substr(1)) != 2 * begin + edges) {
+                return false;
+            }
+            edges++;
+        } else if (line[0] == 'b') {
+            size_t space = line.find(' ');
+            current[line.substr(space + 1)] = line.substr(0, space);
+        } else if (line[0] != '$') {
+            current[line.substr(1)] = line.substr(0, 1);
+        }
+    }
+    return edges == 2 * (end - begin) && check_edge();
+}
+
+int main() {
+    std::cout << "Testing Trace Store (chunked VCD changes, cycle index, window reads)\n";
+    std::cout << "====================================================================\n\n";
+
+    const char* path = "trace_store_test.trc";
+
+    // Test 1: a long golden run (example program, restarted when it halts) round trips
+    std::cout << "Test 1: Store 1000000 cycles\n";
+    std::vector<uint8_t> program = { 0x8A, 0x90, 0xA0, 0xB1, 0x17, 0x29, 0xD1, 0xDF };
+    sCPU cpu;
+    cpu.loadInstructions(program);
+    GoldenAdapter<sCPU> golden(cpu);
+    const uint64_t cycle_count = 1000000;
+    const uint64_t first_cycle = 2;
+    std::vector<uint64_t> samples;
+    FakeTrace trace;
+    TraceStoreWriter writer;
+    writer.open(path, FakeTrace::declarations(), 4096);
+    std::string changes;
+    for (uint64_t i = 0; i < cycle_count; i++) {
+        CommitRecord record;
+        bool reset = i % 100000 < 2;
+        if (reset) {
+            cpu.loadInstructions(program);
+        } else {
+            golden.commit(record);
+        }
+        uint8_t result = reset || !record.written ? (samples.empty() ? 0 : (samples.back() >> 40) & 0xFF) : record.value;
+        samples.push_back(cpu.getPackedState() | ((uint64_t)result << 40) | ((uint64_t)reset << 48));
+
+        changes.clear();
+        for (int clk = 0; clk < 2; clk++) {
+            uint64_t values[FakeTrace::SIGNALS];
+            edge_values(samples, i, clk, values);
+            trace.dump(2 * (first_cycle + i) + clk, values, changes);
+        }
+        if (!writer.append(first_cycle + i, changes.data(), changes.size())) {
+            std::cerr << "  ✗ FAIL: cycle " << first_cycle + i << " not appended\n";
+            return 1;
+        }
+    }
+    if (!writer.close()) {
+        std::cerr << "  ✗ FAIL: cannot write " << path << "\n";
+        return 1;
+    }
+
+    TraceStoreReader reader;
+    if (!reader.open(path) || reader.firstCycle() != first_cycle || reader.cycleCount() != cycle_count
+        || reader.chunkCount() != (cycle_count + 4095) / 4096) {
+        std::cerr << "  ✗ FAIL: stored cycle range differs\n";
+        return 1;
+    }
+    FILE* file = std::fopen(path, "rb");
+    std::fseek(file, 0, SEEK_END);
+    long bytes = std::ftell(file);
+    std::fclose(file);
+    // Mostly a halted loop: two time lines and the clock per cycle
+    if (bytes > (long)cycle_count * 24) {
+        std::cerr << "  ✗ FAIL: " << bytes << " bytes for " << cycle_count << " cycles\n";
+        return 1;
+    }
+    std::cout << "  ✓ " << cycle_count << " cycles in " << bytes << " bytes\n\n";
+
+    // Test 2: random windows, including chunk boundaries and the ends, replay every signal
+    std::cout << "Test 2: Window reads\n";
+    std::mt19937_64 rng(7);
+    std::string vcd;
+    for (int i = 0; i < 300; i++) {
+        uint64_t begin = first_cycle + rng() % cycle_count;
+        uint64_t end = begin + 1 + rng() % 10000;
+        if (i == 0) {
+            begin = 0;
+            end = first_cycle + 4096;
+        } else if (i == 1) {
+            begin = first_cycle + cycle_count - 10;
+            end = begin + 100;
+        } else if (i == 2) {
+            begin = first_cycle + 3 * 4096;
+            end = begin + 1;
+        }
+        if (!reader.readVcd(begin, end, vcd)) {
+            std::cerr << "  ✗ FAIL: read " << begin << ".." << end << "\n";
+            return 1;
+        }
+        uint64_t from = std::max(begin, first_cycle);
+        uint64_t to = std::min(end, first_cycle + cycle_count);
+        if (!check_window(vcd, from, to, first_cycle, samples)) {
+            std::cerr << "  ✗ FAIL: window " << begin << ".." << end << " differs\n";
+            return 1;
+        }
+    }
+    if (!reader.readVcd(first_cycle + cycle_count, first_cycle + cycle_count + 10, vcd) || !vcd.empty()) {
+        std::cerr << "  ✗ FAIL: window past the end is not empty\n";
+        return 1;
+    }
+    std::cout << "  ✓ 300 windows replay every signal, internal ones included\n\n";
+
+    // Test 3: a window opens with a full snapshot, even in the middle of a chunk
+    std::cout << "Test 3: Window starts with every value\n";
+    reader.readVcd(500000, 500010, vcd);
+    size_t body = std::strlen(FakeTrace::declarations());
+    if (vcd.compare(body, 18, "#1000000\n$dumpvars") != 0 || vcd.find("$end\n", body) == std::string::npos
+        || vcd.find("#1000019\n") == std::string::npos || vcd.find("#1000020\n") != std::string::npos) {
+        std::cerr << "  ✗ FAIL: unexpected window\n" << vcd.substr(body, 200) << "\n";
+        return 1;
+    }
+    std::cout << "  ✓ 10 cycles, 20 edges\n\n";
+
+    // Test 4: reject headers and chunk index entries that do not match the fixed chunk grid
+    std::cout << "Test 4: Reject inconsistent chunk index\n";
+    reader.close();
+    writer.open(path, FakeTrace::declarations(), 4096);
+    {
+        FakeTrace short_trace;
+        for (uint64_t i = 0; i < 10000; i++) {
+            changes.clear();
+            for (int clk = 0; clk < 2; clk++) {
+                uint64_t values[FakeTrace::SIGNALS];
+                edge_values(samples, i, clk, values);
+                short_trace.dump(2 * (first_cycle + i) + clk, values, changes);
+            }
+            writer.append(first_cycle + i, changes.data(), changes.size());
+        }
+    }
+    writer.close();
+    file = std::fopen(path, "rb");
+    std::vector<uint8_t> original(bytes);
+    original.resize(std::fread(original.data(), 1, original.size(), file));
+    std::fclose(file);
+    TraceStoreHeader header;
+    std::memcpy(&header, original.data(), sizeof(header));
+    TraceStoreChunk* chunks = reinterpret_cast<TraceStoreChunk*>(&original[header.index_offset]);
+    if (header.chunk_count != 3 || chunks[2].cycles != 10000 - 2 * 4096
+        || header.declarations_size != std::strlen(FakeTrace::declarations())) {
+        std::cerr << "  ✗ FAIL: expected 3 chunks of 4096, 4096 and 1808 cycles\n";
+        return 1;
+    }
+    const char* corruptions[] = {
+        "cycle_count", "chunk_cycles", "first_cycle of chunk 1", "cycles of chunk 2", "offset of chunk 0",
+        "declarations_size", "chunk 0 inside the declarations"
+    };
+    for (int c = 0; c < 7; c++) {
+        std::vector<uint8_t> corrupt = original;
+        TraceStoreHeader* h = reinterpret_cast<TraceStoreHeader*>(corrupt.data());
+        TraceStoreChunk* index = reinterpret_cast<TraceStoreChunk*>(&corrupt[header.index_offset]);
+        switch (c) {
+            case 0: h->cycle_count = 20000; break;
+            case 1: h->chunk_cycles = 1024; break;
+            case 2: index[1].first_cycle++; break;
+            case 3: index[2].cycles = 4096; break;
+            case 4: index[0].offset = header.index_offset; break;
+            case 5: h->declarations_size = ~0ull; break;
+            case 6: index[0].offset = sizeof(TraceStoreHeader); break;
+        }
+        file = std::fopen(path, "wb");
+        std::fwrite(corrupt.data(), 1, corrupt.size(), file);
+        std::fclose(file);
+        if (reader.open(path)) {
+            std::cerr << "  ✗ FAIL: accepted a corrupt " << corruptions[c] << "\n";
+            return 1;
+        }
+    }
+    std::cout << "  ✓ cycle count, chunk size, chunk first cycle, chunk length, offsets and declarations checked\n\n";
+
+    reader.close();
+    std::remove(path);
+    std::cout << "✅ All tests passed!\n";
+    return 0;
+}
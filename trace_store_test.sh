@@ -0,0 +1,24 @@
+g++ -O2 -std=c++17 trace_store_test.cpp trace_store.cpp sCPU.cpp -o trace_store_test
+./trace_store_test
+
+# Full-history trace store of the CPU testbench, then one window of it as a VCD
+g++ -O2 -std=c++17 trace_window.cpp trace_store.cpp -o trace_window
+
+rm -rf obj_dir/
+
+verilator --cc \
+  main.sv \
+  program_counter.sv \
+  instruction_memory.sv \
+  control_unit.sv \
+  register_file.sv \
+  alu.sv \
+  immediate_extend.sv \
+  --exe main_test.cpp sCPU.cpp trace_store.cpp checkpoint.cpp \
+  --trace --savable \
+  -CFLAGS "-O2"
+
+make -C obj_dir -f Vmain.mk -j
+
+./obj_dir/Vmain --trace-store=waveform_cpu.trc
+./trace_window waveform_cpu.trc 10 30 window.vcd
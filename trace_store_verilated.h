@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "trace_ring_verilated.h"
+#include "trace_store.h"
+
+// VerilatedAdapter Trace type: stores every traced signal of the model (built with --trace)
+// in a trace store, one cycle per rising edge
+template <typename VModel>
+class TraceStore {
+    public:
+        explicit TraceStore(VModel& model) : model_(model), capture_(model) {}
+
+        bool open(const std::string& path, uint32_t chunk_cycles = 4096) {
+            return this->writer_.open(path, this->capture_.declarations(), chunk_cycles);
+        }
+
+        // Called by VerilatedAdapter after each clock edge (time counts edges, 2 per cycle)
+        void dump(uint64_t time) {
+            this->cycle_changes_ += this->capture_.dump(time);
+            if (this->model_.clk) {
+                this->writer_.append(time / 2, this->cycle_changes_.data(), this->cycle_changes_.size());
+                this->cycle_changes_.clear();
+            }
+        }
+
+        bool close() {
+            return this->writer_.close();
+        }
+
+        uint64_t cycleCount() const {
+            return this->writer_.cycleCount();
+        }
+
+    private:
+        VModel& model_;
+        VcdCapture<VModel> capture_;
+        TraceStoreWriter writer_;
+
+        // Changes of the falling edge, stored with the rising edge of the same cycle
+        std::string cycle_changes_;
+};
@@ -0,0 +1,63 @@
+// Extracts a cycle window of a trace store (see trace_store.h) as a VCD of every traced
+// signal. Only the chunks covering the window are read, so any window of a billion-cycle
+// run opens instantly.
+//
+// Usage:
+//   ./trace_window <run.trc> <first cycle> <end cycle> [window.vcd]
+// Without a first/end cycle the store is only summarized.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "trace_store.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <run.trc> [<first cycle> <end cycle> [window.vcd]]\n";
+        return 2;
+    }
+
+    TraceStoreReader store;
+    if (!store.open(argv[1])) {
+        return 2;
+    }
+    std::cout << argv[1] << ": cycles " << store.firstCycle() << ".." << store.firstCycle() + store.cycleCount()
+              << " in " << store.chunkCount() << " chunks\n";
+    if (argc == 2) {
+        return 0;
+    }
+
+    uint64_t begin = std::stoull(argv[2]);
+    uint64_t end = std::stoull(argv[3]);
+    std::string output_path = argc == 5 ? argv[4] : "window.vcd";
+
+    auto start = std::chrono::steady_clock::now();
+    std::string vcd;
+    if (!store.readVcd(begin, end, vcd)) {
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t first = std::max(begin, store.firstCycle());
+    uint64_t last = std::min(end, store.firstCycle() + store.cycleCount());
+    if (first >= last) {
+        std::cerr << "err No stored cycles in " << begin << ".." << end << "\n";
+        return 1;
+    }
+
+    FILE* file = std::fopen(output_path.c_str(), "w");
+    bool written = file != nullptr
+                && std::fprintf(file, "$comment cycles %llu..%llu of %s $end\n", (unsigned long long)first,
+                                (unsigned long long)last, argv[1]) > 0
+                && std::fwrite(vcd.data(), 1, vcd.size(), file) == vcd.size();
+    if (file == nullptr || std::fclose(file) != 0 || !written) {
+        std::cerr << "err Cannot write " << output_path << "\n";
+        return 1;
+    }
+    std::cout << "ok " << last - first << " cycles read in " << std::fixed << std::setprecision(3)
+              << seconds * 1000 << " ms, VCD: " << output_path << "\n";
+    return 0;
+}